@@ -0,0 +1,778 @@
+/*
+ * td1208_bench.c
+ *
+ *  Created on: 02 jan. 2026
+ *      Author: Ludo
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "td1208.h"
+#include "td1208_codec.h"
+#include "td1208_hw.h"
+#include "td1208_sim.h"
+#include "types.h"
+
+/*** TD1208 BENCH macros ***/
+
+#define TD1208_BENCH_ITERATIONS_DEFAULT     100
+#define TD1208_BENCH_ITERATIONS_MAX         10000
+
+#define TD1208_BENCH_STACK_SIZE             (256 * 1024)
+#define TD1208_BENCH_STACK_PAINT_SIZE       16384
+#define TD1208_BENCH_STACK_PAINT_MARGIN     64
+#define TD1208_BENCH_STACK_PAINT_PATTERN    0xA5
+
+#define TD1208_BENCH_BATCH_SIZE             4
+
+// Emulated module rejects the highest TX powers.
+#define TD1208_BENCH_TX_POWER_MAX_DBM       10
+
+#define TD1208_BENCH_CODEC_FIELDS_COUNT     4
+#define TD1208_BENCH_CODEC_LOSS_PERIOD      16
+
+/*** TD1208 BENCH structures ***/
+
+/*******************************************************************/
+typedef struct {
+    TD1208_SIM_t sim;
+    TD1208_handle_t handle;
+    // Driver callbacks wrapped for time measurement.
+    TD1208_HW_instance_rx_irq_cb_t rx_irq_callback;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    TD1208_HW_instance_rx_block_cb_t rx_block_callback;
+#endif
+    // Host time counters.
+    uint64_t rx_callback_ns;
+    uint64_t rx_callback_bytes;
+    uint64_t hw_ns;
+    uint8_t hw_nesting;
+    // Replies are injected by the parser benchmark instead of being emulated.
+    uint8_t offline_enable;
+    // Painted window of the scenario thread stack (emulator usage is erased after each hardware call).
+    uint8_t stack_enable;
+    uint32_t stack_floor_idx;
+    uint32_t stack_base_idx;
+    uint32_t stack_low_idx;
+    uint32_t rx_stack_bytes_max;
+    // Reply data of the parser benchmark.
+    uint8_t sigfox_ep_id[TD1208_SIGFOX_EP_ID_SIZE_BYTES];
+    TD1208_downlink_t downlink;
+    // Codec round trip (frames are sometimes lost between the encoder and the decoder).
+    TD1208_CODEC_context_t codec_encoder;
+    TD1208_CODEC_context_t codec_decoder;
+    uint32_t codec_step;
+    uint8_t codec_frame_lost;
+} TD1208_BENCH_context_t;
+
+/*******************************************************************/
+typedef TD1208_status_t (*TD1208_BENCH_step_t)(TD1208_BENCH_context_t* bench);
+
+/*******************************************************************/
+typedef struct {
+    char_t* name;
+    TD1208_BENCH_step_t prepare;
+    TD1208_BENCH_step_t run;
+} TD1208_BENCH_scenario_t;
+
+/*******************************************************************/
+typedef struct {
+    TD1208_BENCH_context_t* bench;
+    const TD1208_BENCH_scenario_t* scenario;
+    uint32_t iterations;
+} TD1208_BENCH_job_t;
+
+/*******************************************************************/
+typedef struct {
+    char_t* name;
+    TD1208_BENCH_step_t start;
+    char_t* reply;
+} TD1208_BENCH_parser_t;
+
+/*** TD1208 BENCH local global variables ***/
+
+// Temperature, humidity, fast flag and counter.
+static const TD1208_CODEC_field_t TD1208_BENCH_CODEC_FIELDS[TD1208_BENCH_CODEC_FIELDS_COUNT] = {
+    { -400, 850, 5, 8, 4 },
+    { 0, 100, 1, 7, 3 },
+    { 0, 1, 1, 1, 0 },
+    { 0, 65535, 1, 16, 0 }
+};
+static const TD1208_CODEC_schema_t TD1208_BENCH_CODEC_SCHEMA = { TD1208_BENCH_CODEC_FIELDS, TD1208_BENCH_CODEC_FIELDS_COUNT, 4, 2 };
+
+static TD1208_BENCH_context_t td1208_bench;
+static uint32_t td1208_bench_latency_us[TD1208_BENCH_ITERATIONS_MAX];
+static uint8_t td1208_bench_stack[TD1208_BENCH_STACK_SIZE] __attribute__((aligned(16)));
+
+/*** TD1208 BENCH local functions ***/
+
+/*******************************************************************/
+static uint64_t _TD1208_BENCH_get_time_ns(void) {
+    // Local variables.
+    struct timespec now;
+    // Read monotonic clock.
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (((uint64_t) now.tv_sec * 1000000000) + (uint64_t) now.tv_nsec);
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_BENCH_stack_idx(volatile uint8_t* marker) {
+    // Offset of a local variable in the scenario thread stack.
+    return (uint32_t) ((uintptr_t) marker - (uintptr_t) td1208_bench_stack);
+}
+
+/*******************************************************************/
+static void __attribute__((noinline)) _TD1208_BENCH_stack_paint(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    volatile uint8_t marker = 0;
+    volatile uint8_t* byte = NULL;
+    uint32_t limit_idx = (_TD1208_BENCH_stack_idx(&marker) - TD1208_BENCH_STACK_PAINT_MARGIN);
+    // Fill the free part of the window without calling any function, the margin protects the frame of this function.
+    if ((bench->stack_enable != 0) && (limit_idx > bench->stack_floor_idx) && (limit_idx < TD1208_BENCH_STACK_SIZE)) {
+        for (byte = &(td1208_bench_stack[bench->stack_floor_idx]); byte < &(td1208_bench_stack[limit_idx]); byte++) {
+            (*byte) = TD1208_BENCH_STACK_PAINT_PATTERN;
+        }
+    }
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_BENCH_stack_scan(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint32_t idx = bench->stack_floor_idx;
+    // Stack grows downward: the first byte which is not painted is the deepest one used since the last paint.
+    while ((idx < bench->stack_base_idx) && (td1208_bench_stack[idx] == TD1208_BENCH_STACK_PAINT_PATTERN)) {
+        idx++;
+    }
+    return idx;
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_stack_update(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint32_t low_idx = 0;
+    // Record driver usage before the painted window is used by the emulator.
+    if (bench->stack_enable != 0) {
+        low_idx = _TD1208_BENCH_stack_scan(bench);
+        if (low_idx < bench->stack_low_idx) {
+            bench->stack_low_idx = low_idx;
+        }
+    }
+}
+
+/*******************************************************************/
+static int _TD1208_BENCH_compare(const void* a, const void* b) {
+    // Local variables.
+    uint32_t value_a = *((const uint32_t*) a);
+    uint32_t value_b = *((const uint32_t*) b);
+    // Ascending order.
+    return ((value_a > value_b) - (value_a < value_b));
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_BENCH_percentile(uint32_t* sorted, uint32_t count, uint32_t percent) {
+    // Nearest rank.
+    return sorted[((count * percent) + 99) / 100 - 1];
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_rx_stack_update(TD1208_BENCH_context_t* bench, volatile uint8_t* marker) {
+    // Local variables.
+    uint32_t marker_idx = _TD1208_BENCH_stack_idx(marker);
+    uint32_t low_idx = 0;
+    // Depth of the driver callback below the wrapper frame.
+    if ((bench->stack_enable != 0) && (marker_idx < TD1208_BENCH_STACK_SIZE)) {
+        low_idx = _TD1208_BENCH_stack_scan(bench);
+        if ((marker_idx > low_idx) && ((marker_idx - low_idx) > bench->rx_stack_bytes_max)) {
+            bench->rx_stack_bytes_max = (marker_idx - low_idx);
+        }
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_rx_irq_callback(TD1208_handle_t* handle, uint8_t data) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = &td1208_bench;
+    volatile uint8_t marker = 0;
+    uint64_t start_ns = 0;
+    // Call driver (interrupt context on target, so its stack usage is measured separately).
+    _TD1208_BENCH_stack_paint(bench);
+    start_ns = _TD1208_BENCH_get_time_ns();
+    bench->rx_irq_callback(handle, data);
+    bench->rx_callback_ns += (_TD1208_BENCH_get_time_ns() - start_ns);
+    bench->rx_callback_bytes++;
+    _TD1208_BENCH_rx_stack_update(bench, &marker);
+}
+
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+/*******************************************************************/
+static void _TD1208_BENCH_rx_block_callback(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = &td1208_bench;
+    volatile uint8_t marker = 0;
+    uint64_t start_ns = 0;
+    // Call driver (interrupt context on target, so its stack usage is measured separately).
+    _TD1208_BENCH_stack_paint(bench);
+    start_ns = _TD1208_BENCH_get_time_ns();
+    bench->rx_block_callback(handle, data, data_size_bytes);
+    bench->rx_callback_ns += (_TD1208_BENCH_get_time_ns() - start_ns);
+    bench->rx_callback_bytes += data_size_bytes;
+    _TD1208_BENCH_rx_stack_update(bench, &marker);
+}
+#endif
+
+/*******************************************************************/
+static uint64_t _TD1208_BENCH_hw_enter(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint64_t start_ns = 0;
+    // Nested calls (from the driver RX callback called by the emulator) are accounted by the outer call.
+    if (bench->hw_nesting == 0) {
+        start_ns = _TD1208_BENCH_get_time_ns();
+        _TD1208_BENCH_stack_update(bench);
+    }
+    bench->hw_nesting++;
+    return start_ns;
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_hw_exit(TD1208_BENCH_context_t* bench, uint64_t start_ns) {
+    // Account emulator time and erase its stack usage.
+    bench->hw_nesting--;
+    if (bench->hw_nesting == 0) {
+        _TD1208_BENCH_stack_paint(bench);
+        bench->hw_ns += (_TD1208_BENCH_get_time_ns() - start_ns);
+    }
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_init(void* hw_context, TD1208_HW_configuration_t* configuration) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    TD1208_HW_configuration_t wrapped_configuration = (*configuration);
+    uint64_t start_ns = 0;
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Insert measurement callbacks.
+    bench->rx_irq_callback = configuration->instance_rx_irq_callback;
+    wrapped_configuration.rx_irq_callback = NULL;
+    wrapped_configuration.instance_rx_irq_callback = &_TD1208_BENCH_rx_irq_callback;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    bench->rx_block_callback = configuration->instance_rx_block_callback;
+    wrapped_configuration.rx_block_callback = NULL;
+    wrapped_configuration.instance_rx_block_callback = &_TD1208_BENCH_rx_block_callback;
+#endif
+    start_ns = _TD1208_BENCH_hw_enter(bench);
+    status = TD1208_SIM_OPS.init(&(bench->sim), &wrapped_configuration);
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_de_init(void* hw_context) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SIM_OPS.de_init(&(bench->sim));
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_uart_write(void* hw_context, uint8_t* data, uint32_t data_size_bytes) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Commands are dropped when replies are injected.
+    if (bench->offline_enable == 0) {
+        status = TD1208_SIM_OPS.uart_write(&(bench->sim), data, data_size_bytes);
+    }
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_uart_write_vector(void* hw_context, TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Commands are dropped when replies are injected.
+    if (bench->offline_enable == 0) {
+        status = TD1208_SIM_OPS.uart_write_vector(&(bench->sim), buffers, buffers_count);
+    }
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_set_baud_rate(void* hw_context, uint32_t baud_rate) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SIM_OPS.set_baud_rate(&(bench->sim), baud_rate);
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_delay_milliseconds(void* hw_context, uint32_t delay_ms) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SIM_OPS.delay_milliseconds(&(bench->sim), delay_ms);
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_hw_wait_event(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_status_t status = TD1208_SIM_OPS.wait_event(&(bench->sim), timeout_ms, elapsed_ms);
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+    return status;
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_hw_signal_event(void* hw_context) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = (TD1208_BENCH_context_t*) hw_context;
+    uint64_t start_ns = _TD1208_BENCH_hw_enter(bench);
+    TD1208_SIM_OPS.signal_event(&(bench->sim));
+    _TD1208_BENCH_hw_exit(bench, start_ns);
+}
+
+/*** TD1208 BENCH scenarios ***/
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_none(TD1208_BENCH_context_t* bench) {
+    UNUSED(bench);
+    return TD1208_SUCCESS;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_de_init(TD1208_BENCH_context_t* bench) {
+    return TD1208_instance_de_init(&(bench->handle));
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_init(TD1208_BENCH_context_t* bench);
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_reset(TD1208_BENCH_context_t* bench) {
+    return TD1208_instance_reset(&(bench->handle));
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_get_sigfox_ep_id(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t sigfox_ep_id[TD1208_SIGFOX_EP_ID_SIZE_BYTES];
+    // Read EP ID.
+    return TD1208_instance_get_sigfox_ep_id(&(bench->handle), sigfox_ep_id);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_get_module_info(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    TD1208_module_info_t module_info;
+    // Read module information.
+    return TD1208_instance_get_module_info(&(bench->handle), &module_info);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_bit(TD1208_BENCH_context_t* bench) {
+    return TD1208_instance_send_bit(&(bench->handle), 1);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_frame(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    // Send maximum size frame.
+    return TD1208_instance_send_frame(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_frame_single(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    TD1208_tx_options_t tx_options = { 0, 0, 0 };
+    // Send maximum size frame without repetition.
+    return TD1208_instance_send_frame_with_options(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX, &tx_options);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_frame_tx_power(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    TD1208_tx_options_t tx_options = { TD1208_TX_REPEATS_MAX, 1, TD1208_BENCH_TX_POWER_MAX_DBM };
+    // Send maximum size frame after setting the TX power (the setting is forgotten by the reset of the prepare step).
+    return TD1208_instance_send_frame_with_options(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX, &tx_options);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_frame_tx_power_rejected(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    TD1208_tx_options_t tx_options = { TD1208_TX_REPEATS_MAX, 1, TD1208_TX_POWER_DBM_MAX };
+    // The uplink must report that the requested power has not been applied.
+    status = TD1208_instance_send_frame_with_options(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX, &tx_options);
+    status = (status == TD1208_ERROR_TX_POWER) ? TD1208_SUCCESS : TD1208_ERROR_UNEXPECTED_REPLY;
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_send_frame_with_downlink(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    TD1208_downlink_t downlink;
+    // Send maximum size frame and wait for the downlink.
+    return TD1208_instance_send_frame_with_downlink(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX, &downlink);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_execute_batch(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    TD1208_command_t commands[TD1208_BENCH_BATCH_SIZE] = {
+        { "AT", TD1208_LINE_KIND_OK, 0 },
+        { "ATI7", TD1208_LINE_KIND_OK, 0 },
+        { "ATI11", TD1208_LINE_KIND_OK, 0 },
+        { "ATI13", TD1208_LINE_KIND_OK, 0 }
+    };
+    TD1208_status_t commands_status[TD1208_BENCH_BATCH_SIZE];
+    // Pipeline commands.
+    return TD1208_instance_execute_batch(&(bench->handle), commands, TD1208_BENCH_BATCH_SIZE, commands_status);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_codec_round_trip(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_CODEC_frame_t frame;
+    int32_t values[TD1208_BENCH_CODEC_FIELDS_COUNT];
+    int32_t decoded_values[TD1208_BENCH_CODEC_FIELDS_COUNT];
+    int32_t error = 0;
+    uint8_t first_idx = 0;
+    uint8_t last_idx = (TD1208_BENCH_CODEC_FIELDS_COUNT - 1);
+    uint8_t idx = 0;
+    // Slowly varying values with a fast flag toggle.
+    bench->codec_step++;
+    values[0] = (int32_t) ((bench->codec_step * 7) % 200) - 50;
+    values[1] = (int32_t) ((bench->codec_step / 3) % 101);
+    values[2] = (int32_t) ((bench->codec_step / 5) % 2);
+    values[3] = 1000;
+    status = TD1208_CODEC_encode(&(bench->codec_encoder), values, &frame);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Lost uplink (a lost single bit is corrected by the next frame since the fast flag is never delta encoded).
+    if ((bench->codec_step % TD1208_BENCH_CODEC_LOSS_PERIOD) == 0) {
+        if (frame.bit_frame == 0) {
+            bench->codec_frame_lost = 1;
+        }
+        goto errors;
+    }
+    status = TD1208_CODEC_decode(&(bench->codec_decoder), &frame, decoded_values);
+    if (bench->codec_frame_lost != 0) {
+        if (frame.bit_frame != 0) {
+            // A single bit can't reveal the lost frame: only the fast flag is up to date.
+            if (status == TD1208_ERROR_CODEC_FRAME) {
+                status = TD1208_SUCCESS;
+                goto errors;
+            }
+            first_idx = TD1208_BENCH_CODEC_SCHEMA.fast_flag_field_idx;
+            last_idx = TD1208_BENCH_CODEC_SCHEMA.fast_flag_field_idx;
+        }
+        else if (bench->codec_encoder.delta_frames_count != 0) {
+            // Delta frames must be rejected after a lost frame, until the next absolute frame.
+            if (status == TD1208_SUCCESS) {
+                status = TD1208_ERROR_CODEC_FRAME;
+            }
+            else if (status == TD1208_ERROR_CODEC_FRAME) {
+                status = TD1208_SUCCESS;
+            }
+            goto errors;
+        }
+        else {
+            bench->codec_frame_lost = 0;
+        }
+    }
+    if (status != TD1208_SUCCESS) goto errors;
+    // Decoded values only differ by the quantization error.
+    for (idx = first_idx; idx <= last_idx; idx++) {
+        error = (decoded_values[idx] - values[idx]);
+        if ((error < 0 ? -error : error) > (int32_t) (TD1208_BENCH_CODEC_FIELDS[idx].quantization >> 1)) {
+            status = TD1208_ERROR_CODEC_FRAME;
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static const TD1208_BENCH_scenario_t TD1208_BENCH_SCENARIOS[] = {
+    { "init", &_TD1208_BENCH_de_init, &_TD1208_BENCH_init },
+    { "reset", &_TD1208_BENCH_none, &_TD1208_BENCH_reset },
+    { "get_sigfox_ep_id", &_TD1208_BENCH_reset, &_TD1208_BENCH_get_sigfox_ep_id },
+    { "get_sigfox_ep_id_cached", &_TD1208_BENCH_get_sigfox_ep_id, &_TD1208_BENCH_get_sigfox_ep_id },
+    { "get_module_info", &_TD1208_BENCH_reset, &_TD1208_BENCH_get_module_info },
+    { "execute_batch", &_TD1208_BENCH_none, &_TD1208_BENCH_execute_batch },
+    { "send_bit", &_TD1208_BENCH_none, &_TD1208_BENCH_send_bit },
+    { "send_frame", &_TD1208_BENCH_none, &_TD1208_BENCH_send_frame },
+    { "send_frame_single", &_TD1208_BENCH_none, &_TD1208_BENCH_send_frame_single },
+    { "send_frame_tx_power", &_TD1208_BENCH_reset, &_TD1208_BENCH_send_frame_tx_power },
+    { "send_frame_tx_power_rejected", &_TD1208_BENCH_none, &_TD1208_BENCH_send_frame_tx_power_rejected },
+    { "send_frame_with_downlink", &_TD1208_BENCH_none, &_TD1208_BENCH_send_frame_with_downlink },
+    { "codec_round_trip", &_TD1208_BENCH_none, &_TD1208_BENCH_codec_round_trip }
+};
+
+/*** TD1208 BENCH parsers ***/
+
+/*******************************************************************/
+static void _TD1208_BENCH_inject(TD1208_BENCH_context_t* bench, char_t* reply) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Feed the driver RX callback directly.
+    for (idx = 0; reply[idx] != STRING_CHAR_NULL; idx++) {
+        bench->rx_irq_callback(&(bench->handle), (uint8_t) reply[idx]);
+    }
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_start_get_sigfox_ep_id(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Invalidate cache with a reset.
+    status = TD1208_instance_start_reset(&(bench->handle), NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    _TD1208_BENCH_inject(bench, "OK\r\n");
+    status = TD1208_instance_process(&(bench->handle), 0);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Start query.
+    status = TD1208_instance_start_get_sigfox_ep_id(&(bench->handle), bench->sigfox_ep_id, NULL);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_start_send_frame_with_downlink(TD1208_BENCH_context_t* bench) {
+    // Local variables.
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB };
+    // Start uplink.
+    return TD1208_instance_start_send_frame_with_downlink(&(bench->handle), ul_payload, TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX, &(bench->downlink), NULL);
+}
+
+/*******************************************************************/
+static const TD1208_BENCH_parser_t TD1208_BENCH_PARSERS[] = {
+    { "sigfox_ep_id", &_TD1208_BENCH_start_get_sigfox_ep_id, "0123ABCD\r\nOK\r\n" },
+    { "downlink", &_TD1208_BENCH_start_send_frame_with_downlink, "OK\r\n+RX=00 11 22 33 44 55 66 77,-120\r\n+RX END\r\n" }
+};
+
+/*******************************************************************/
+static const TD1208_HW_ops_t TD1208_BENCH_OPS = {
+    .init = &_TD1208_BENCH_hw_init,
+    .de_init = &_TD1208_BENCH_hw_de_init,
+    .uart_write = &_TD1208_BENCH_hw_uart_write,
+    .uart_write_vector = &_TD1208_BENCH_hw_uart_write_vector,
+    .set_baud_rate = &_TD1208_BENCH_hw_set_baud_rate,
+    .delay_milliseconds = &_TD1208_BENCH_hw_delay_milliseconds,
+    .wait_event = &_TD1208_BENCH_hw_wait_event,
+    .signal_event = &_TD1208_BENCH_hw_signal_event
+};
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_BENCH_init(TD1208_BENCH_context_t* bench) {
+    return TD1208_instance_init(&(bench->handle), &TD1208_BENCH_OPS, bench);
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_run_scenario(TD1208_BENCH_context_t* bench, const TD1208_BENCH_scenario_t* scenario, uint32_t iterations) {
+    // Local variables.
+    TD1208_SIM_statistics_t statistics_before;
+    TD1208_SIM_statistics_t statistics_after;
+    uint64_t sim_time_before_us = 0;
+    uint64_t sim_time_after_us = 0;
+    uint64_t host_ns = 0;
+    uint64_t driver_ns = 0;
+    uint64_t start_ns = 0;
+    uint64_t hw_ns = 0;
+    uint64_t rx_callback_ns = 0;
+    uint64_t rx_callback_bytes = 0;
+    uint64_t tx_bytes = 0;
+    uint64_t rx_bytes = 0;
+    volatile uint8_t stack_marker = 0;
+    uint32_t stack_bytes = 0;
+    uint32_t stack_bytes_max = 0;
+    uint32_t errors = 0;
+    uint32_t idx = 0;
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Stack window is located below the frame of this function.
+    bench->stack_base_idx = _TD1208_BENCH_stack_idx(&stack_marker);
+    bench->stack_floor_idx = (bench->stack_base_idx - TD1208_BENCH_STACK_PAINT_SIZE);
+    bench->rx_stack_bytes_max = 0;
+    // Iterations.
+    for (idx = 0; idx < iterations; idx++) {
+        if (scenario->prepare(bench) != TD1208_SUCCESS) {
+            errors++;
+        }
+        TD1208_SIM_get_statistics(&(bench->sim), &statistics_before);
+        TD1208_SIM_get_time(&(bench->sim), &sim_time_before_us);
+        bench->hw_ns = 0;
+        bench->rx_callback_ns = 0;
+        bench->rx_callback_bytes = 0;
+        // Timed call.
+        bench->stack_low_idx = bench->stack_base_idx;
+        bench->stack_enable = 1;
+        _TD1208_BENCH_stack_paint(bench);
+        start_ns = _TD1208_BENCH_get_time_ns();
+        status = scenario->run(bench);
+        host_ns += (_TD1208_BENCH_get_time_ns() - start_ns);
+        _TD1208_BENCH_stack_update(bench);
+        bench->stack_enable = 0;
+        stack_bytes = (bench->stack_base_idx - bench->stack_low_idx);
+        // Update counters.
+        if (status != TD1208_SUCCESS) {
+            errors++;
+        }
+        if (stack_bytes > stack_bytes_max) {
+            stack_bytes_max = stack_bytes;
+        }
+        TD1208_SIM_get_statistics(&(bench->sim), &statistics_after);
+        TD1208_SIM_get_time(&(bench->sim), &sim_time_after_us);
+        td1208_bench_latency_us[idx] = (uint32_t) (sim_time_after_us - sim_time_before_us);
+        hw_ns += bench->hw_ns;
+        rx_callback_ns += bench->rx_callback_ns;
+        rx_callback_bytes += bench->rx_callback_bytes;
+        tx_bytes += (statistics_after.tx_bytes_count - statistics_before.tx_bytes_count);
+        rx_bytes += (statistics_after.rx_bytes_count - statistics_before.rx_bytes_count);
+    }
+    // Driver time: total time without emulator, but including the RX callback called from the emulator.
+    driver_ns = (host_ns > hw_ns) ? (host_ns - hw_ns + rx_callback_ns) : rx_callback_ns;
+    qsort(td1208_bench_latency_us, iterations, sizeof(uint32_t), &_TD1208_BENCH_compare);
+    // Print JSON line.
+    printf("{\"scenario\":\"%s\",\"iterations\":%u,\"errors\":%u,", scenario->name, iterations, errors);
+    printf("\"latency_us\":{\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u},",
+           _TD1208_BENCH_percentile(td1208_bench_latency_us, iterations, 50),
+           _TD1208_BENCH_percentile(td1208_bench_latency_us, iterations, 90),
+           _TD1208_BENCH_percentile(td1208_bench_latency_us, iterations, 99),
+           td1208_bench_latency_us[iterations - 1]);
+    printf("\"host_ns_per_call\":%llu,\"driver_ns_per_call\":%llu,\"rx_callback_ns_per_byte\":%llu,",
+           (unsigned long long) (host_ns / iterations),
+           (unsigned long long) (driver_ns / iterations),
+           (unsigned long long) ((rx_callback_bytes == 0) ? 0 : (rx_callback_ns / rx_callback_bytes)));
+    printf("\"tx_bytes_per_call\":%llu,\"rx_bytes_per_call\":%llu,\"stack_bytes_max\":%u,\"rx_stack_bytes_max\":%u}\n",
+           (unsigned long long) (tx_bytes / iterations),
+           (unsigned long long) (rx_bytes / iterations),
+           stack_bytes_max,
+           bench->rx_stack_bytes_max);
+}
+
+/*******************************************************************/
+static void* _TD1208_BENCH_thread(void* argument) {
+    // Local variables.
+    TD1208_BENCH_job_t* job = (TD1208_BENCH_job_t*) argument;
+    // Run scenario on the measured stack.
+    _TD1208_BENCH_run_scenario(job->bench, job->scenario, job->iterations);
+    return NULL;
+}
+
+/*******************************************************************/
+static void _TD1208_BENCH_run_parser(TD1208_BENCH_context_t* bench, const TD1208_BENCH_parser_t* parser, uint32_t iterations) {
+    // Local variables.
+    uint64_t process_ns = 0;
+    uint64_t start_ns = 0;
+    uint32_t errors = 0;
+    uint32_t idx = 0;
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Commands are not sent to the emulator.
+    bench->offline_enable = 1;
+    for (idx = 0; idx < iterations; idx++) {
+        status = parser->start(bench);
+        if (status != TD1208_SUCCESS) {
+            errors++;
+            continue;
+        }
+        _TD1208_BENCH_inject(bench, parser->reply);
+        // Timed reply matching and parsing.
+        start_ns = _TD1208_BENCH_get_time_ns();
+        status = TD1208_instance_process(&(bench->handle), 0);
+        process_ns += (_TD1208_BENCH_get_time_ns() - start_ns);
+        if ((status != TD1208_SUCCESS) || (bench->handle.command_count != 0) || (bench->handle.last_command_status != TD1208_SUCCESS)) {
+            errors++;
+        }
+    }
+    bench->offline_enable = 0;
+    // Print JSON line.
+    printf("{\"parser\":\"%s\",\"iterations\":%u,\"errors\":%u,\"process_ns_per_call\":%llu}\n",
+           parser->name, iterations, errors, (unsigned long long) (process_ns / iterations));
+}
+
+/*** TD1208 BENCH main function ***/
+
+/*******************************************************************/
+int main(int argc, char* argv[]) {
+    // Local variables.
+    TD1208_BENCH_context_t* bench = &td1208_bench;
+    TD1208_SIM_configuration_t sim_configuration;
+    TD1208_BENCH_job_t job;
+    pthread_attr_t thread_attributes;
+    pthread_t thread;
+    uint32_t iterations = TD1208_BENCH_ITERATIONS_DEFAULT;
+    uint32_t idx = 0;
+    // Parse arguments: [iterations] [seed].
+    TD1208_SIM_get_default_configuration(&sim_configuration);
+    if (argc > 1) {
+        iterations = (uint32_t) strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        sim_configuration.random_seed = (uint32_t) strtoul(argv[2], NULL, 10);
+    }
+    if ((iterations == 0) || (iterations > TD1208_BENCH_ITERATIONS_MAX)) {
+        fprintf(stderr, "usage: %s [iterations (1 to %u)] [seed]\n", argv[0], TD1208_BENCH_ITERATIONS_MAX);
+        return 1;
+    }
+    // Realistic serial peer.
+    sim_configuration.latency_jitter_us = 2000;
+    sim_configuration.fragment_size_max = 8;
+    sim_configuration.fragment_gap_us = 500;
+    sim_configuration.tx_power_max_dbm = TD1208_BENCH_TX_POWER_MAX_DBM;
+    TD1208_SIM_setup(&(bench->sim), &sim_configuration);
+    if (_TD1208_BENCH_init(bench) != TD1208_SUCCESS) {
+        fprintf(stderr, "TD1208 initialization failed\n");
+        return 1;
+    }
+    if ((TD1208_CODEC_init(&(bench->codec_encoder), &TD1208_BENCH_CODEC_SCHEMA) != TD1208_SUCCESS) || (TD1208_CODEC_init(&(bench->codec_decoder), &TD1208_BENCH_CODEC_SCHEMA) != TD1208_SUCCESS)) {
+        fprintf(stderr, "TD1208 codec initialization failed\n");
+        return 1;
+    }
+    // Run all scenarios on a thread using the painted stack.
+    pthread_attr_init(&thread_attributes);
+    if (pthread_attr_setstack(&thread_attributes, td1208_bench_stack, TD1208_BENCH_STACK_SIZE) != 0) {
+        fprintf(stderr, "stack setup failed\n");
+        return 1;
+    }
+    job.bench = bench;
+    job.iterations = iterations;
+    for (idx = 0; idx < (sizeof(TD1208_BENCH_SCENARIOS) / sizeof(TD1208_BENCH_scenario_t)); idx++) {
+        job.scenario = &(TD1208_BENCH_SCENARIOS[idx]);
+        if (pthread_create(&thread, &thread_attributes, &_TD1208_BENCH_thread, &job) != 0) {
+            fprintf(stderr, "thread creation failed\n");
+            return 1;
+        }
+        pthread_join(thread, NULL);
+    }
+    pthread_attr_destroy(&thread_attributes);
+    // Reply parsing only.
+    for (idx = 0; idx < (sizeof(TD1208_BENCH_PARSERS) / sizeof(TD1208_BENCH_parser_t)); idx++) {
+        _TD1208_BENCH_run_parser(bench, &(TD1208_BENCH_PARSERS[idx]), iterations);
+    }
+    TD1208_instance_de_init(&(bench->handle));
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include "td1208_driver_flags.h"
 #endif
 #include "error.h"
+#include "maths.h"
 #include "parser.h"
 #include "strings.h"
 #include "types.h"
@@ -20,6 +21,29 @@
 
 #define TD1208_SIGFOX_EP_ID_SIZE_BYTES              4
 #define TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX     12
+#define TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES         8
+
+#define TD1208_MODULE_INFO_REVISION_SIZE_CHAR       32
+
+#define TD1208_TX_REPEATS_MAX                       2
+#define TD1208_TX_POWER_DBM_MAX                     14
+
+#define TD1208_RX_BUFFER_SIZE_BYTES                 128
+#define TD1208_RX_BLOCK_BUFFER_SIZE_BYTES           64
+#define TD1208_LINE_INDEX_DEPTH                     8
+#define TD1208_COMMAND_QUEUE_DEPTH                  4
+#define TD1208_UPLINK_QUEUE_DEPTH                   8
+#define TD1208_CAPTURE_BUFFER_SIZE_BYTES            512
+
+// Capture record: header byte (direction and data size), time since previous record in ms (7 bits per byte, LSB first, bit 7 set when more bytes follow) and data.
+#define TD1208_CAPTURE_RECORD_DIRECTION_TX          0x00
+#define TD1208_CAPTURE_RECORD_DIRECTION_RX          0x80
+#define TD1208_CAPTURE_RECORD_SIZE_MASK             0x7F
+#define TD1208_CAPTURE_RECORD_TIME_SIZE_BYTES_MAX   5
+
+#define TD1208_SIGFOX_UL_PAYLOAD_SIZE_CHAR          (TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX * MATH_U8_SIZE_HEXADECIMAL_DIGITS)
+// Repeats argument appended to the payload (",<repeats>", omitted for a frame without downlink request sent with full repeats).
+#define TD1208_TX_REPEATS_SIZE_CHAR                 2
 
 /*** TD1208 structures ***/
 
@@ -33,6 +57,19 @@ typedef enum {
     TD1208_ERROR_NULL_PARAMETER,
     TD1208_ERROR_SIGFOX_UL_PAYLOAD_SIZE,
     TD1208_ERROR_REPLY_TIMEOUT,
+    TD1208_ERROR_UNEXPECTED_REPLY,
+    TD1208_ERROR_RX_OVERRUN,
+    TD1208_ERROR_BAUD_RATE,
+    TD1208_ERROR_BUSY,
+    TD1208_ERROR_COMMAND_REJECTED,
+    TD1208_ERROR_DOWNLINK_TIMEOUT,
+    TD1208_ERROR_TIMEOUT_PROFILE,
+    TD1208_ERROR_UPLINK_QUEUE_FULL,
+    TD1208_ERROR_CODEC_SCHEMA,
+    TD1208_ERROR_CODEC_FRAME,
+    TD1208_ERROR_TX_REPEATS,
+    TD1208_ERROR_TX_POWER,
+    TD1208_ERROR_COMMAND_ABORTED,
     // Low level drivers errors.
     TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED,
     TD1208_ERROR_BASE_UART = ERROR_BASE_STEP,
@@ -43,13 +80,303 @@ typedef enum {
     TD1208_ERROR_BASE_LAST = (TD1208_ERROR_BASE_PARSER + PARSER_ERROR_BASE_LAST)
 } TD1208_status_t;
 
+/*!******************************************************************
+ * \enum TD1208_line_kind_t
+ * \brief TD1208 reply line kinds.
+ *******************************************************************/
+typedef enum {
+    TD1208_LINE_KIND_OK = 0,
+    TD1208_LINE_KIND_ERROR,
+    TD1208_LINE_KIND_HEXADECIMAL,
+    TD1208_LINE_KIND_UNSOLICITED,
+    TD1208_LINE_KIND_LAST
+} TD1208_line_kind_t;
+
+/*!******************************************************************
+ * \enum TD1208_timeout_profile_t
+ * \brief TD1208 command timeout profiles.
+ *******************************************************************/
+typedef enum {
+    TD1208_TIMEOUT_PROFILE_COMMAND = 0,
+    TD1208_TIMEOUT_PROFILE_RESET,
+    TD1208_TIMEOUT_PROFILE_UPLINK,
+    TD1208_TIMEOUT_PROFILE_DOWNLINK,
+    TD1208_TIMEOUT_PROFILE_LAST
+} TD1208_timeout_profile_t;
+
+/*!******************************************************************
+ * \struct TD1208_command_t
+ * \brief Generic AT command descriptor.
+ *******************************************************************/
+typedef struct {
+    char_t* command;
+    TD1208_line_kind_t expected_reply;
+    uint32_t timeout_ms;
+} TD1208_command_t;
+
+/*!******************************************************************
+ * \struct TD1208_module_info_t
+ * \brief TD1208 immutable module information.
+ *******************************************************************/
+typedef struct {
+    uint8_t sigfox_ep_id[TD1208_SIGFOX_EP_ID_SIZE_BYTES];
+    char_t hardware_revision[TD1208_MODULE_INFO_REVISION_SIZE_CHAR];
+    char_t firmware_revision[TD1208_MODULE_INFO_REVISION_SIZE_CHAR];
+} TD1208_module_info_t;
+
+/*!******************************************************************
+ * \struct TD1208_downlink_t
+ * \brief Sigfox downlink frame.
+ *******************************************************************/
+typedef struct {
+    uint8_t dl_payload[TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES];
+    int16_t rssi_dbm;
+    uint8_t rssi_valid;
+} TD1208_downlink_t;
+
+/*!******************************************************************
+ * \struct TD1208_tx_options_t
+ * \brief Uplink transmission options.
+ *******************************************************************/
+typedef struct {
+    // Number of frame repetitions (0 for the single frame low energy mode, TD1208_TX_REPEATS_MAX for full redundancy).
+    uint8_t repeats;
+    // Output power set with ATS302 before the uplink (the module keeps the previous setting when disabled, the uplink completes with TD1208_ERROR_TX_POWER when the module rejects the power).
+    uint8_t tx_power_enable;
+    uint8_t tx_power_dbm;
+} TD1208_tx_options_t;
+
+// Driver instance (defined below).
+struct TD1208_handle_s;
+
+/*!******************************************************************
+ * \fn TD1208_completion_cb_t
+ * \brief Asynchronous command completion callback.
+ * \param[in]   handle: Pointer to the driver instance which executed the command (default instance when started with a TD1208_start_xxx() function).
+ * \param[in]   status: Command completion status.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+typedef void (*TD1208_completion_cb_t)(struct TD1208_handle_s* handle, TD1208_status_t status);
+
+#ifdef TD1208_DRIVER_STATISTICS
+/*!******************************************************************
+ * \struct TD1208_statistics_t
+ * \brief TD1208 driver statistics counters.
+ *******************************************************************/
+typedef struct {
+    // Commands outcomes.
+    uint32_t commands_sent_count;
+    uint32_t commands_success_count;
+    uint32_t commands_timeout_count;
+    uint32_t commands_unexpected_reply_count;
+    uint32_t commands_rx_overrun_count;
+    uint32_t commands_rejected_count;
+    uint32_t commands_other_error_count;
+    // Commands latency (from transmission to completion).
+    uint32_t command_latency_min_ms;
+    uint32_t command_latency_average_ms;
+    uint32_t command_latency_max_ms;
+    // UART.
+    uint32_t tx_bytes_count;
+    uint32_t rx_bytes_count;
+    uint32_t rx_buffer_wrap_count;
+    uint32_t rx_overrun_count;
+    // Lines.
+    uint32_t unsolicited_lines_count;
+    uint32_t unmatched_lines_count;
+    // Time spent in wait and delay functions (including low power mode).
+    uint32_t blocked_time_ms;
+    uint32_t sleep_time_ms;
+} TD1208_statistics_t;
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*!******************************************************************
+ * \struct TD1208_uplink_parameters_t
+ * \brief Uplink queue entry parameters.
+ *******************************************************************/
+typedef struct {
+    uint8_t priority;
+    uint32_t deadline_ms;
+    uint8_t coalescing_enable;
+} TD1208_uplink_parameters_t;
+
+/*!******************************************************************
+ * \struct TD1208_uplink_queue_status_t
+ * \brief Uplink queue state and counters.
+ *******************************************************************/
+typedef struct {
+    uint8_t queue_depth;
+    uint8_t budget_remaining;
+    uint32_t enqueued_count;
+    uint32_t coalesced_count;
+    uint32_t frames_sent_count;
+    uint32_t frames_failed_count;
+    uint32_t retries_count;
+    uint32_t dropped_full_count;
+    uint32_t dropped_expired_count;
+    uint32_t dropped_retries_count;
+} TD1208_uplink_queue_status_t;
+
+/*!******************************************************************
+ * \struct TD1208_uplink_t
+ * \brief Uplink queue entry.
+ *******************************************************************/
+typedef struct {
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX];
+    uint8_t ul_payload_size_bytes;
+    uint8_t priority;
+    uint8_t coalescing_enable;
+    uint8_t deadline_enable;
+    uint32_t deadline_ms;
+    uint32_t sequence;
+} TD1208_uplink_t;
+#endif
+
+// Hardware operations table (defined in td1208_hw.h).
+struct TD1208_HW_ops_s;
+
+/*!******************************************************************
+ * \struct TD1208_line_t
+ * \brief Received line descriptor.
+ *******************************************************************/
+typedef struct {
+    uint8_t offset;
+    uint8_t size;
+    TD1208_line_kind_t kind;
+} TD1208_line_t;
+
+/*!******************************************************************
+ * \enum TD1208_reply_data_t
+ * \brief Data to extract from the reply of a pending command.
+ *******************************************************************/
+typedef enum {
+    TD1208_REPLY_DATA_NONE = 0,
+    TD1208_REPLY_DATA_SIGFOX_EP_ID,
+    TD1208_REPLY_DATA_TEXT,
+    TD1208_REPLY_DATA_DOWNLINK,
+    TD1208_REPLY_DATA_LAST
+} TD1208_reply_data_t;
+
+/*!******************************************************************
+ * \struct TD1208_pending_command_t
+ * \brief Pending command descriptor.
+ *******************************************************************/
+typedef struct {
+    TD1208_line_kind_t expected_kind;
+    uint32_t timeout_ms;
+    TD1208_timeout_profile_t timeout_profile;
+    TD1208_reply_data_t reply_data;
+    uint8_t* data;
+    uint8_t data_size;
+    TD1208_status_t* status;
+    TD1208_completion_cb_t completion_callback;
+    // Uplink sent right after a TX power command, which fails if the module rejected the power.
+    uint8_t tx_power_check;
+} TD1208_pending_command_t;
+
+/*!******************************************************************
+ * \struct TD1208_handle_t
+ * \brief TD1208 driver instance.
+ *******************************************************************/
+typedef struct TD1208_handle_s {
+    // Hardware interface.
+    const struct TD1208_HW_ops_s* hw_ops;
+    void* hw_context;
+    // UART.
+    uint32_t uart_baud_rate;
+    // Commands timeout.
+    uint32_t timeout_ms[TD1208_TIMEOUT_PROFILE_LAST];
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+    uint32_t timeout_learned_latency_ms[TD1208_TIMEOUT_PROFILE_LAST];
+    uint8_t timeout_learned_samples[TD1208_TIMEOUT_PROFILE_LAST];
+#endif
+    // RX ring buffer (single producer under interrupt, single consumer in process function).
+    volatile char_t rx_buffer[TD1208_RX_BUFFER_SIZE_BYTES];
+    volatile uint8_t rx_write_idx;
+    volatile uint8_t rx_read_idx;
+    volatile uint8_t rx_overrun_count;
+    uint8_t rx_overrun_read_count;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    uint8_t rx_block_buffer[TD1208_RX_BLOCK_BUFFER_SIZE_BYTES];
+#endif
+    // Lines index.
+    volatile TD1208_line_t line[TD1208_LINE_INDEX_DEPTH];
+    volatile uint8_t line_write_count;
+    volatile uint8_t line_read_count;
+    uint8_t line_start_idx;
+    uint8_t line_flags;
+    // TX buffer.
+    char_t ul_payload_hex[TD1208_SIGFOX_UL_PAYLOAD_SIZE_CHAR + TD1208_TX_REPEATS_SIZE_CHAR + 1];
+    // Commands queue (all queued commands have been sent, replies are matched in FIFO order).
+    TD1208_pending_command_t command[TD1208_COMMAND_QUEUE_DEPTH];
+    uint8_t command_head_idx;
+    uint8_t command_count;
+    // Oldest pending command.
+    uint32_t elapsed_ms;
+    uint8_t reply_received;
+    uint8_t reply_data_found;
+    uint8_t uplink_acknowledged;
+    TD1208_status_t last_command_status;
+    // Module information cache.
+    TD1208_module_info_t module_info;
+    uint8_t sigfox_ep_id_valid;
+    uint8_t module_info_valid;
+    // Module TX power (sent again before the next uplink unless tx_power_status is TD1208_SUCCESS).
+    uint8_t tx_power_dbm;
+    TD1208_status_t tx_power_status;
+    // Duration of the last completed command (from the start of its processing by the module to its final reply).
+    uint32_t last_command_duration_ms;
+#ifdef TD1208_DRIVER_STATISTICS
+    // Statistics (RX counters are updated under interrupt).
+    TD1208_statistics_t statistics;
+    volatile uint32_t statistics_rx_bytes_count;
+    volatile uint32_t statistics_rx_buffer_wrap_count;
+    volatile uint32_t statistics_rx_overrun_count;
+    uint32_t statistics_time_ms;
+    uint32_t statistics_latency_total_ms;
+    uint32_t statistics_command_start_ms[TD1208_COMMAND_QUEUE_DEPTH];
+#endif
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+    // Uplink queue (unsorted, entries are selected by priority then deadline then sequence).
+    TD1208_uplink_t uplink[TD1208_UPLINK_QUEUE_DEPTH];
+    uint8_t uplink_count;
+    uint32_t uplink_sequence;
+    uint32_t uplink_time_ms;
+    // Messages budget (token bucket refilled over one hour).
+    uint32_t uplink_period_ms;
+    uint32_t uplink_credit_ms;
+    // Frame being sent (kept until success or retries exhaustion).
+    uint8_t uplink_frame[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX];
+    uint8_t uplink_frame_size_bytes;
+    uint8_t uplink_frame_retries;
+    uint8_t uplink_frame_pending;
+    uint8_t uplink_frame_in_flight;
+    TD1208_status_t uplink_frame_status;
+    TD1208_uplink_queue_status_t uplink_queue_status;
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    // UART traffic capture ring (RX records are written under interrupt, TX records and reading in critical section).
+    uint8_t capture_buffer[TD1208_CAPTURE_BUFFER_SIZE_BYTES];
+    volatile uint16_t capture_write_idx;
+    volatile uint16_t capture_read_idx;
+    volatile uint32_t capture_dropped_records_count;
+    uint32_t capture_time_ms;
+    uint32_t capture_clock_ms;
+    // RX bytes are recorded line by line.
+    uint8_t capture_rx_chunk[TD1208_CAPTURE_RECORD_SIZE_MASK];
+    uint8_t capture_rx_chunk_size;
+#endif
+} TD1208_handle_t;
+
 #ifndef TD1208_DRIVER_DISABLE
 
 /*** TD1208 functions ***/
 
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_init(void)
- * \brief Init TD1208 driver.
+ * \brief Init TD1208 driver default instance (using the TD1208_HW_xxx() functions).
  * \param[in]   none
  * \param[out]  none
  * \retval      Function execution status.
@@ -58,13 +385,124 @@ TD1208_status_t TD1208_init(void);
 
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_de_init(void)
- * \brief Release TD1208 driver.
+ * \brief Release TD1208 driver, pending commands are completed with TD1208_ERROR_COMMAND_ABORTED.
  * \param[in]   none
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
 TD1208_status_t TD1208_de_init(void);
 
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_set_baud_rate(uint32_t baud_rate)
+ * \brief Switch TD1208 and hardware interface to a new UART baud rate and verify the link (the previous baud rate is restored on both sides on failure).
+ * \param[in]   baud_rate: New UART baud rate, from 1200 to 115200.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_set_baud_rate(uint32_t baud_rate);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_set_timeout(TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms)
+ * \brief Set the reply timeout of a command profile (maximum value when timeout learning is enabled).
+ * \param[in]   timeout_profile: Commands profile to configure.
+ * \param[in]   timeout_ms: Reply timeout in ms.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_set_timeout(TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_process(uint32_t elapsed_ms)
+ * \brief Process TD1208 driver (to be called on reply event and periodically while asynchronous commands are pending).
+ * \param[in]   elapsed_ms: Time elapsed since the previous call in ms, used to manage the reply timeout.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_process(uint32_t elapsed_ms);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_execute_batch(TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status)
+ * \brief Execute a list of AT commands, several commands are sent before receiving the replies which are matched in order.
+ * \param[in]   commands: List of commands to execute (command string without ending CR, timeout set to 0 to use the TD1208_TIMEOUT_PROFILE_COMMAND value).
+ * \param[in]   commands_count: Number of commands in the list.
+ * \param[out]  commands_status: Pointer to the array that will contain the status of each command.
+ * \retval      Function execution status (status of the first failed command if any).
+ *******************************************************************/
+TD1208_status_t TD1208_execute_batch(TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_reset(TD1208_completion_cb_t completion_callback)
+ * \brief Start TD1208 chip reset without blocking.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_reset(TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_get_sigfox_ep_id(uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback)
+ * \brief Start TD1208 Sigfox EP ID reading without blocking (the callback is immediately called if the value is cached).
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  sigfox_ep_id: Pointer to byte array that will contain the Sigfox EP ID (must remain valid until completion).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_get_sigfox_ep_id(uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_send_bit(uint8_t ul_bit, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a bit over Sigfox network without blocking.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_send_bit(uint8_t ul_bit, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network without blocking (no other command must be pending).
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network and request a downlink (completed when the closing line of the RX exchange is received, or 2 seconds after the RX line).
+ * \param[in]   ul_payload: Byte array to send (encoded before the function returns).
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   completion_callback: Function called when the command is completed (can be NULL).
+ * \param[out]  downlink: Pointer to the structure that will contain the downlink frame (must remain valid until command completion).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a bit over Sigfox network with given repeats and TX power without blocking.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   tx_options: Pointer to the transmission options (TD1208_start_send_bit() uses TD1208_TX_REPEATS_MAX repeats and the current TX power).
+ * \param[in]   completion_callback: Function called when the uplink is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_start_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network with given repeats and TX power without blocking (no other command must be pending).
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   tx_options: Pointer to the transmission options (TD1208_start_send_frame() uses TD1208_TX_REPEATS_MAX repeats and the current TX power).
+ * \param[in]   completion_callback: Function called when the uplink is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_start_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback);
+
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_reset(void)
  * \brief Reset TD1208 chip.
@@ -76,13 +514,31 @@ TD1208_status_t TD1208_reset(void);
 
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_get_sigfox_ep_id(uint8_t* sigfox_ep_id)
- * \brief Get TD1208 Sigfox EP ID.
+ * \brief Get TD1208 Sigfox EP ID (the value is cached until the next reset).
  * \param[in]   none
  * \param[out]  sigfox_ep_id: Pointer to byte array that will contain the Sigfox EP ID.
  * \retval      Function execution status.
  *******************************************************************/
 TD1208_status_t TD1208_get_sigfox_ep_id(uint8_t* sigfox_ep_id);
 
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_get_module_info(TD1208_module_info_t* module_info)
+ * \brief Get TD1208 Sigfox EP ID, hardware and firmware revisions (the values are cached until the next reset).
+ * \param[in]   none
+ * \param[out]  module_info: Pointer to the structure that will contain the module information.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_get_module_info(TD1208_module_info_t* module_info);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_invalidate_module_info(void)
+ * \brief Invalidate the cached Sigfox EP ID and module information, so that the next query reads the module.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_invalidate_module_info(void);
+
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_send_bit(uint8_t ul_bit)
  * \brief Send a bit over Sigfox network.
@@ -102,6 +558,403 @@ TD1208_status_t TD1208_send_bit(uint8_t ul_bit);
  *******************************************************************/
 TD1208_status_t TD1208_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes);
 
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink)
+ * \brief Send a frame over Sigfox network and wait for the downlink frame.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[out]  downlink: Pointer to the structure that will contain the downlink frame.
+ * \retval      Function execution status (TD1208_ERROR_DOWNLINK_TIMEOUT if the uplink succeeded but no downlink was received).
+ *******************************************************************/
+TD1208_status_t TD1208_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options)
+ * \brief Send a bit over Sigfox network with given repeats and TX power.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   tx_options: Pointer to the transmission options.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options)
+ * \brief Send a frame over Sigfox network with given repeats and TX power.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   tx_options: Pointer to the transmission options.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_get_last_command_duration(uint32_t* duration_ms)
+ * \brief Get the measured duration of the last completed command (radio time of an uplink when read after its completion).
+ * \param[in]   none
+ * \param[out]  duration_ms: Pointer to the duration in ms (resolution is given by the elapsed time passed to TD1208_process()).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_get_last_command_duration(uint32_t* duration_ms);
+
+#ifdef TD1208_DRIVER_STATISTICS
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_get_statistics(TD1208_statistics_t* statistics)
+ * \brief Read TD1208 driver statistics counters (reset by TD1208_init()).
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the structure that will contain the counters.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_get_statistics(TD1208_statistics_t* statistics);
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_enqueue_uplink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters)
+ * \brief Push a payload in the uplink queue (frames are sent by TD1208_process() when the driver is idle and the messages budget allows it).
+ * \param[in]   ul_payload: Byte array to send (copied in the queue).
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   parameters: Priority (highest first), deadline in ms from now (0 for none) and coalescing with other small payloads (payloads are concatenated without any framing, so coalescable payloads must be self-delimiting).
+ * \param[out]  none
+ * \retval      Function execution status (TD1208_ERROR_UPLINK_QUEUE_FULL if no lower priority entry can be dropped).
+ *******************************************************************/
+TD1208_status_t TD1208_enqueue_uplink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_set_uplink_budget(uint8_t messages_per_hour)
+ * \brief Set the maximum number of uplink frames sent by the queue per hour (6 by default).
+ * \param[in]   messages_per_hour: Messages budget.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_set_uplink_budget(uint8_t messages_per_hour);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_get_uplink_queue_status(TD1208_uplink_queue_status_t* uplink_queue_status)
+ * \brief Read the uplink queue depth, remaining budget and drop counters (reset by TD1208_init()).
+ * \param[in]   none
+ * \param[out]  uplink_queue_status: Pointer to the structure that will contain the queue status.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_get_uplink_queue_status(TD1208_uplink_queue_status_t* uplink_queue_status);
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_read_capture(uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count)
+ * \brief Read and remove the oldest UART capture records (see TD1208_CAPTURE_RECORD_xxx macros for the binary format).
+ * \param[in]   data_size_bytes: Size of the destination buffer (only complete records are copied).
+ * \param[out]  data: Destination buffer.
+ * \param[out]  read_size_bytes: Pointer to the number of bytes copied.
+ * \param[out]  dropped_records_count: Pointer to the number of records overwritten since the previous read.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_read_capture(uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count);
+#endif
+
+/*** TD1208 instance functions ***/
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_init(TD1208_handle_t* handle, const struct TD1208_HW_ops_s* hw_ops, void* hw_context)
+ * \brief Init a TD1208 driver instance.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   hw_ops: Pointer to the hardware interface operations of the instance.
+ * \param[in]   hw_context: Opaque pointer given back to all hardware operations of the instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_init(TD1208_handle_t* handle, const struct TD1208_HW_ops_s* hw_ops, void* hw_context);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_de_init(TD1208_handle_t* handle)
+ * \brief Release TD1208 driver, pending commands are completed with TD1208_ERROR_COMMAND_ABORTED.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_de_init(TD1208_handle_t* handle);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_set_baud_rate(TD1208_handle_t* handle, uint32_t baud_rate)
+ * \brief Switch TD1208 and hardware interface to a new UART baud rate and verify the link (the previous baud rate is restored on both sides on failure).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   baud_rate: New UART baud rate, from 1200 to 115200.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_set_baud_rate(TD1208_handle_t* handle, uint32_t baud_rate);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_set_timeout(TD1208_handle_t* handle, TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms)
+ * \brief Set the reply timeout of a command profile (maximum value when timeout learning is enabled).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   timeout_profile: Commands profile to configure.
+ * \param[in]   timeout_ms: Reply timeout in ms.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_set_timeout(TD1208_handle_t* handle, TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_reset(TD1208_handle_t* handle, TD1208_completion_cb_t completion_callback)
+ * \brief Start TD1208 chip reset without blocking.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_reset(TD1208_handle_t* handle, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback)
+ * \brief Start TD1208 Sigfox EP ID reading without blocking (the callback is immediately called if the value is cached).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  sigfox_ep_id: Pointer to byte array that will contain the Sigfox EP ID (must remain valid until completion).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_send_bit(TD1208_handle_t* handle, uint8_t ul_bit, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a bit over Sigfox network without blocking.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_send_bit(TD1208_handle_t* handle, uint8_t ul_bit, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network without blocking (no other command must be pending).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network and request a downlink (completed when the closing line of the RX exchange is received, or 2 seconds after the RX line).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send (encoded before the function returns).
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   completion_callback: Function called when the command is completed (may be NULL).
+ * \param[out]  downlink: Pointer to the structure that will contain the downlink frame (must remain valid until command completion).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a bit over Sigfox network with given repeats and TX power without blocking.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   tx_options: Pointer to the transmission options (TD1208_instance_start_send_bit() uses TD1208_TX_REPEATS_MAX repeats and the current TX power).
+ * \param[in]   completion_callback: Function called when the uplink is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_start_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback)
+ * \brief Start sending a frame over Sigfox network with given repeats and TX power without blocking (no other command must be pending).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   tx_options: Pointer to the transmission options (TD1208_instance_start_send_frame() uses TD1208_TX_REPEATS_MAX repeats and the current TX power).
+ * \param[in]   completion_callback: Function called when the uplink is completed (may be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_process(TD1208_handle_t* handle, uint32_t elapsed_ms)
+ * \brief Process TD1208 driver (to be called on reply event and periodically while asynchronous commands are pending).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   elapsed_ms: Time elapsed since the previous call in ms, used to manage the reply timeout.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_process(TD1208_handle_t* handle, uint32_t elapsed_ms);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_execute_batch(TD1208_handle_t* handle, TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status)
+ * \brief Execute a list of AT commands, several commands are sent before receiving the replies which are matched in order.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   commands: List of commands to execute (command string without ending CR, timeout set to 0 to use the TD1208_TIMEOUT_PROFILE_COMMAND value).
+ * \param[in]   commands_count: Number of commands in the list.
+ * \param[out]  commands_status: Pointer to the array that will contain the status of each command.
+ * \retval      Function execution status (status of the first failed command if any).
+ *******************************************************************/
+TD1208_status_t TD1208_instance_execute_batch(TD1208_handle_t* handle, TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_reset(TD1208_handle_t* handle)
+ * \brief Reset TD1208 chip.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_reset(TD1208_handle_t* handle);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id)
+ * \brief Get TD1208 Sigfox EP ID (the value is cached until the next reset).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  sigfox_ep_id: Pointer to byte array that will contain the Sigfox EP ID.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_get_module_info(TD1208_handle_t* handle, TD1208_module_info_t* module_info)
+ * \brief Get TD1208 Sigfox EP ID, hardware and firmware revisions (the values are cached until the next reset).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  module_info: Pointer to the structure that will contain the module information.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_get_module_info(TD1208_handle_t* handle, TD1208_module_info_t* module_info);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_invalidate_module_info(TD1208_handle_t* handle)
+ * \brief Invalidate the cached Sigfox EP ID and module information, so that the next query reads the module.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_invalidate_module_info(TD1208_handle_t* handle);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_send_bit(TD1208_handle_t* handle, uint8_t ul_bit)
+ * \brief Send a bit over Sigfox network.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_send_bit(TD1208_handle_t* handle, uint8_t ul_bit);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes)
+ * \brief Send a frame over Sigfox network.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink)
+ * \brief Send a frame over Sigfox network and wait for the downlink frame.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[out]  downlink: Pointer to the structure that will contain the downlink frame.
+ * \retval      Function execution status (TD1208_ERROR_DOWNLINK_TIMEOUT if the uplink succeeded but no downlink was received).
+ *******************************************************************/
+TD1208_status_t TD1208_instance_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options)
+ * \brief Send a bit over Sigfox network with given repeats and TX power.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_bit: Bit to send.
+ * \param[in]   tx_options: Pointer to the transmission options.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options)
+ * \brief Send a frame over Sigfox network with given repeats and TX power.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send.
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   tx_options: Pointer to the transmission options.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_get_last_command_duration(TD1208_handle_t* handle, uint32_t* duration_ms)
+ * \brief Get the measured duration of the last completed command (radio time of an uplink when read after its completion).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  duration_ms: Pointer to the duration in ms (resolution is given by the elapsed time passed to TD1208_instance_process()).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_get_last_command_duration(TD1208_handle_t* handle, uint32_t* duration_ms);
+
+#ifdef TD1208_DRIVER_STATISTICS
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_get_statistics(TD1208_handle_t* handle, TD1208_statistics_t* statistics)
+ * \brief Read TD1208 driver statistics counters (reset by TD1208_instance_init()).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  statistics: Pointer to the structure that will contain the counters.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_get_statistics(TD1208_handle_t* handle, TD1208_statistics_t* statistics);
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_enqueue_uplink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters)
+ * \brief Push a payload in the uplink queue (frames are sent by TD1208_instance_process() when the driver is idle and the messages budget allows it).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   ul_payload: Byte array to send (copied in the queue).
+ * \param[in]   ul_payload_size_bytes: Number of bytes to send.
+ * \param[in]   parameters: Priority (highest first), deadline in ms from now (0 for none) and coalescing with other small payloads (payloads are concatenated without any framing, so coalescable payloads must be self-delimiting).
+ * \param[out]  none
+ * \retval      Function execution status (TD1208_ERROR_UPLINK_QUEUE_FULL if no lower priority entry can be dropped).
+ *******************************************************************/
+TD1208_status_t TD1208_instance_enqueue_uplink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_set_uplink_budget(TD1208_handle_t* handle, uint8_t messages_per_hour)
+ * \brief Set the maximum number of uplink frames sent by the queue per hour (6 by default).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   messages_per_hour: Messages budget.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_set_uplink_budget(TD1208_handle_t* handle, uint8_t messages_per_hour);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_get_uplink_queue_status(TD1208_handle_t* handle, TD1208_uplink_queue_status_t* uplink_queue_status)
+ * \brief Read the uplink queue depth, remaining budget and drop counters (reset by TD1208_instance_init()).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[out]  uplink_queue_status: Pointer to the structure that will contain the queue status.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_get_uplink_queue_status(TD1208_handle_t* handle, TD1208_uplink_queue_status_t* uplink_queue_status);
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_instance_read_capture(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count)
+ * \brief Read and remove the oldest UART capture records (see TD1208_CAPTURE_RECORD_xxx macros for the binary format).
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   data_size_bytes: Size of the destination buffer (only complete records are copied).
+ * \param[out]  data: Destination buffer.
+ * \param[out]  read_size_bytes: Pointer to the number of bytes copied.
+ * \param[out]  dropped_records_count: Pointer to the number of records overwritten since the previous read.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_instance_read_capture(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count);
+#endif
+
 /*******************************************************************/
 #define TD1208_exit_error(base) { ERROR_check_exit(td1208_status, TD1208_SUCCESS, base) }
 
@@ -0,0 +1,140 @@
+/*
+ * td1208_codec.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TD1208_CODEC_H__
+#define __TD1208_CODEC_H__
+
+#ifndef TD1208_DRIVER_DISABLE_FLAGS_FILE
+#include "td1208_driver_flags.h"
+#endif
+#include "td1208.h"
+#include "types.h"
+
+#ifndef TD1208_DRIVER_DISABLE
+
+/*** TD1208 CODEC macros ***/
+
+#define TD1208_CODEC_FIELDS_MAX             16
+#define TD1208_CODEC_FIELD_SIZE_BITS_MAX    32
+#define TD1208_CODEC_FAST_FLAG_NONE         0xFF
+
+/*** TD1208 CODEC structures ***/
+
+/*!******************************************************************
+ * \struct TD1208_CODEC_field_t
+ * \brief Telemetry field description (values are clamped to the range then quantized).
+ *******************************************************************/
+typedef struct {
+    int32_t minimum;
+    int32_t maximum;
+    uint32_t quantization;
+    uint8_t size_bits;
+    uint8_t delta_size_bits;
+} TD1208_CODEC_field_t;
+
+/*!******************************************************************
+ * \struct TD1208_CODEC_schema_t
+ * \brief Telemetry frame description shared by the device encoder and the backend decoder.
+ *******************************************************************/
+typedef struct {
+    const TD1208_CODEC_field_t* fields;
+    uint8_t fields_count;
+    // Maximum number of delta frames between two absolute frames (0 to disable delta encoding).
+    uint8_t keyframe_period;
+    // Single bit field sent with TD1208_send_bit() when it is the only change (TD1208_CODEC_FAST_FLAG_NONE to disable).
+    uint8_t fast_flag_field_idx;
+} TD1208_CODEC_schema_t;
+
+/*!******************************************************************
+ * \struct TD1208_CODEC_context_t
+ * \brief Encoder or decoder state (last quantized values and frame sequence number).
+ *******************************************************************/
+typedef struct {
+    const TD1208_CODEC_schema_t* schema;
+    uint32_t previous_code[TD1208_CODEC_FIELDS_MAX];
+    uint8_t previous_valid;
+    uint8_t delta_frames_count;
+    // Rolling sequence number of the next frame (sent by the encoder, expected by the decoder).
+    uint8_t sequence;
+} TD1208_CODEC_context_t;
+
+/*!******************************************************************
+ * \struct TD1208_CODEC_frame_t
+ * \brief Encoded uplink (frame or single bit).
+ *******************************************************************/
+typedef struct {
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX];
+    uint8_t ul_payload_size_bytes;
+    uint8_t bit_frame;
+    uint8_t ul_bit;
+} TD1208_CODEC_frame_t;
+
+/*** TD1208 CODEC functions ***/
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_init(TD1208_CODEC_context_t* context, const TD1208_CODEC_schema_t* schema)
+ * \brief Check a schema and reset the codec state (the next frame is absolute).
+ * \param[in]   context: Pointer to the codec state.
+ * \param[in]   schema: Pointer to the frame description (must remain valid while the context is used).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_init(TD1208_CODEC_context_t* context, const TD1208_CODEC_schema_t* schema);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_force_keyframe(TD1208_CODEC_context_t* context)
+ * \brief Encode the next frame as an absolute frame (to be called when an uplink has been lost).
+ * \param[in]   context: Pointer to the codec state.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_force_keyframe(TD1208_CODEC_context_t* context);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_encode(TD1208_CODEC_context_t* context, const int32_t* values, TD1208_CODEC_frame_t* frame)
+ * \brief Pack field values in the smallest uplink (single bit, delta frame or absolute frame) and update the encoder state.
+ * \param[in]   context: Pointer to the encoder state.
+ * \param[in]   values: Field values in schema order.
+ * \param[out]  frame: Pointer to the encoded uplink.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_encode(TD1208_CODEC_context_t* context, const int32_t* values, TD1208_CODEC_frame_t* frame);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_decode(TD1208_CODEC_context_t* context, const TD1208_CODEC_frame_t* frame, int32_t* values)
+ * \brief Unpack a received uplink and update the decoder state (backend side).
+ * \param[in]   context: Pointer to the decoder state.
+ * \param[in]   frame: Pointer to the received uplink.
+ * \param[out]  values: Field values in schema order (quantized).
+ * \retval      Function execution status (TD1208_ERROR_CODEC_FRAME for a delta frame received after a lost frame, until the next absolute frame).
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_decode(TD1208_CODEC_context_t* context, const TD1208_CODEC_frame_t* frame, int32_t* values);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_send(TD1208_CODEC_context_t* context, const int32_t* values)
+ * \brief Encode field values and send the resulting uplink with TD1208_send_bit() or TD1208_send_frame().
+ * \param[in]   context: Pointer to the encoder state (an absolute frame is forced after a failed uplink).
+ * \param[in]   values: Field values in schema order.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_send(TD1208_CODEC_context_t* context, const int32_t* values);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_CODEC_instance_send(TD1208_handle_t* handle, TD1208_CODEC_context_t* context, const int32_t* values)
+ * \brief Encode field values and send the resulting uplink with TD1208_instance_send_bit() or TD1208_instance_send_frame() on a given driver instance.
+ * \param[in]   handle: Pointer to the driver instance.
+ * \param[in]   context: Pointer to the encoder state (an absolute frame is forced after a failed uplink).
+ * \param[in]   values: Field values in schema order.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_CODEC_instance_send(TD1208_handle_t* handle, TD1208_CODEC_context_t* context, const int32_t* values);
+
+#endif /* TD1208_DRIVER_DISABLE */
+
+#endif /* __TD1208_CODEC_H__ */
@@ -24,15 +24,89 @@
  *******************************************************************/
 typedef void (*TD1208_HW_rx_irq_cb_t)(uint8_t data);
 
+/*!******************************************************************
+ * \fn TD1208_HW_instance_rx_irq_cb_t
+ * \brief Byte reception interrupt callback of a driver instance.
+ *******************************************************************/
+typedef void (*TD1208_HW_instance_rx_irq_cb_t)(TD1208_handle_t* handle, uint8_t data);
+
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+/*!******************************************************************
+ * \fn TD1208_HW_rx_block_cb_t
+ * \brief Block reception callback (DMA half / full transfer or UART idle line interrupt).
+ *******************************************************************/
+typedef void (*TD1208_HW_rx_block_cb_t)(uint8_t* data, uint32_t data_size_bytes);
+
+/*!******************************************************************
+ * \fn TD1208_HW_instance_rx_block_cb_t
+ * \brief Block reception callback of a driver instance.
+ *******************************************************************/
+typedef void (*TD1208_HW_instance_rx_block_cb_t)(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes);
+#endif
+
 /*!******************************************************************
  * \struct TD1208_HW_configuration_t
  * \brief TD1208 hardware interface parameters.
  *******************************************************************/
 typedef struct {
     uint32_t uart_baud_rate;
+    // Default instance callback (NULL for other instances).
     TD1208_HW_rx_irq_cb_t rx_irq_callback;
+    // Instance callback (to be called with the handle field).
+    TD1208_handle_t* handle;
+    TD1208_HW_instance_rx_irq_cb_t instance_rx_irq_callback;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    uint8_t* rx_block_buffer;
+    uint32_t rx_block_buffer_size_bytes;
+    TD1208_HW_rx_block_cb_t rx_block_callback;
+    TD1208_HW_instance_rx_block_cb_t instance_rx_block_callback;
+#endif
 } TD1208_HW_configuration_t;
 
+/*!******************************************************************
+ * \struct TD1208_HW_uart_buffer_t
+ * \brief UART buffer descriptor used for scatter/gather transmission.
+ *******************************************************************/
+typedef struct {
+    uint8_t* data;
+    uint32_t size_bytes;
+} TD1208_HW_uart_buffer_t;
+
+/*!******************************************************************
+ * \struct TD1208_HW_ops_t
+ * \brief Hardware operations of a driver instance (see TD1208_HW_xxx() functions for details, optional operations can be NULL).
+ *******************************************************************/
+typedef struct TD1208_HW_ops_s {
+    TD1208_status_t (*init)(void* hw_context, TD1208_HW_configuration_t* configuration);
+    TD1208_status_t (*de_init)(void* hw_context);
+    TD1208_status_t (*uart_write)(void* hw_context, uint8_t* data, uint32_t data_size_bytes);
+    TD1208_status_t (*uart_write_vector)(void* hw_context, TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count);
+    TD1208_status_t (*set_baud_rate)(void* hw_context, uint32_t baud_rate);
+    TD1208_status_t (*delay_milliseconds)(void* hw_context, uint32_t delay_ms);
+    TD1208_status_t (*wait_event)(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms);
+    void (*signal_event)(void* hw_context);
+    TD1208_status_t (*sleep_until_event)(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms);
+    TD1208_status_t (*get_power_state)(void* hw_context, uint8_t* module_powered);
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    void (*mutex_lock)(void* hw_context);
+    void (*mutex_unlock)(void* hw_context);
+    void (*transaction_lock)(void* hw_context);
+    void (*transaction_unlock)(void* hw_context);
+#endif
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+    void (*enter_critical)(void* hw_context);
+    void (*exit_critical)(void* hw_context);
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    TD1208_status_t (*get_time_ms)(void* hw_context, uint32_t* time_ms);
+#endif
+} TD1208_HW_ops_t;
+
+/*** TD1208 HW global variables ***/
+
+// Operations table of the default instance, calling the TD1208_HW_xxx() functions.
+extern const TD1208_HW_ops_t TD1208_HW_DEFAULT_OPS;
+
 /*** TD1208 HW functions ***/
 
 /*!******************************************************************
@@ -63,6 +137,25 @@ TD1208_status_t TD1208_HW_de_init(void);
  *******************************************************************/
 TD1208_status_t TD1208_HW_uart_write(uint8_t* data, uint32_t data_size_bytes);
 
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_uart_write_vector(TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count)
+ * \brief Send several buffers consecutively over the TD1208 control interface (optional, the driver calls TD1208_HW_uart_write() for each buffer when not implemented).
+ * \param[in]   buffers: List of buffers to send (the descriptors list is only valid during the call, the data remains valid until the command completion).
+ * \param[in]   buffers_count: Number of buffers in the list.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_uart_write_vector(TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_set_baud_rate(uint32_t baud_rate)
+ * \brief Update the baud rate of the TD1208 control interface (optional, required by TD1208_set_baud_rate()).
+ * \param[in]   baud_rate: New UART baud rate.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_set_baud_rate(uint32_t baud_rate);
+
 /*!******************************************************************
  * \fn TD1208_status_t TD1208_HW_delay_milliseconds(uint32_t delay_ms)
  * \brief Delay function.
@@ -72,6 +165,111 @@ TD1208_status_t TD1208_HW_uart_write(uint8_t* data, uint32_t data_size_bytes);
  *******************************************************************/
 TD1208_status_t TD1208_HW_delay_milliseconds(uint32_t delay_ms);
 
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_wait_event(uint32_t timeout_ms, uint32_t* elapsed_ms)
+ * \brief Wait for a reply event signaled by the driver (optional, the driver uses polling when not implemented).
+ * \param[in]   timeout_ms: Maximum waiting time in ms.
+ * \param[out]  elapsed_ms: Pointer to the effective waiting time in ms.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_wait_event(uint32_t timeout_ms, uint32_t* elapsed_ms);
+
+/*!******************************************************************
+ * \fn void TD1208_HW_signal_event(void)
+ * \brief Signal a reply event (called under RX interrupt context each time a complete line is received, must be kept until next TD1208_HW_wait_event() call).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_signal_event(void);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_sleep_until_event(uint32_t timeout_ms, uint32_t* elapsed_ms)
+ * \brief Enter low power mode until a reply event is signaled or the timeout expires (optional, the driver uses TD1208_HW_wait_event() then polling when not implemented).
+ * \param[in]   timeout_ms: Maximum sleeping time in ms (a wake-up timer must be programmed accordingly).
+ * \param[out]  elapsed_ms: Pointer to the effective sleeping time in ms.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_sleep_until_event(uint32_t timeout_ms, uint32_t* elapsed_ms);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_get_power_state(uint8_t* module_powered)
+ * \brief Report whether the module stayed powered since the previous initialization (optional, the driver performs a cold boot when not implemented).
+ * \param[in]   none
+ * \param[out]  module_powered: Pointer to the power state (non zero to skip the boot sequence).
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_get_power_state(uint8_t* module_powered);
+
+#ifdef TD1208_DRIVER_THREAD_SAFE
+/*!******************************************************************
+ * \fn void TD1208_HW_mutex_lock(void)
+ * \brief Take the mutex protecting the driver state (optional, held for short sections only, must be recursive since completion callbacks and blocking functions call the driver again).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_mutex_lock(void);
+
+/*!******************************************************************
+ * \fn void TD1208_HW_mutex_unlock(void)
+ * \brief Give the mutex protecting the driver state (optional).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_mutex_unlock(void);
+
+/*!******************************************************************
+ * \fn void TD1208_HW_transaction_lock(void)
+ * \brief Take the mutex serializing the radio transactions (optional, held until the reply of blocking functions so that the state mutex can be released while waiting, must be recursive, the default implementation takes the state mutex).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_transaction_lock(void);
+
+/*!******************************************************************
+ * \fn void TD1208_HW_transaction_unlock(void)
+ * \brief Give the mutex serializing the radio transactions (optional, the default implementation gives the state mutex).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_transaction_unlock(void);
+#endif
+
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+/*!******************************************************************
+ * \fn void TD1208_HW_enter_critical(void)
+ * \brief Mask the RX interrupt while the driver updates the reception state (optional, never nested).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_enter_critical(void);
+
+/*!******************************************************************
+ * \fn void TD1208_HW_exit_critical(void)
+ * \brief Unmask the RX interrupt (optional).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TD1208_HW_exit_critical(void);
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_HW_get_time_ms(uint32_t* time_ms)
+ * \brief Read a free running millisecond clock used to timestamp capture records (optional, called under RX interrupt, the driver uses the time given to TD1208_process() when not implemented).
+ * \param[in]   none
+ * \param[out]  time_ms: Pointer to the current time in ms.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_HW_get_time_ms(uint32_t* time_ms);
+#endif
+
 #endif /* TD1208_DRIVER_DISABLE */
 
 #endif /* __TD1208_HW_H__ */
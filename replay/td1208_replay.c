@@ -0,0 +1,284 @@
+/*
+ * td1208_replay.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "td1208.h"
+#include "td1208_hw.h"
+#include "td1208_sim.h"
+#include "types.h"
+
+/*** TD1208 REPLAY macros ***/
+
+#define TD1208_REPLAY_LOG_SIZE_BYTES_MAX    (1024 * 1024)
+#define TD1208_REPLAY_BATCH_SIZE_MAX        8
+
+/*** TD1208 REPLAY structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t direction;
+    uint8_t size;
+    uint32_t delta_ms;
+    const uint8_t* data;
+    uint32_t next_idx;
+} TD1208_REPLAY_record_t;
+
+/*******************************************************************/
+typedef struct {
+    // Commands sent back to back (without reply in between) are replayed as a batch.
+    char_t command[TD1208_REPLAY_BATCH_SIZE_MAX][TD1208_CAPTURE_RECORD_SIZE_MASK + 1];
+    uint8_t commands_count;
+    uint32_t record_idx;
+    uint32_t captured_latency_ms;
+} TD1208_REPLAY_group_t;
+
+/*** TD1208 REPLAY local global variables ***/
+
+static uint8_t td1208_replay_log[TD1208_REPLAY_LOG_SIZE_BYTES_MAX];
+
+/*** TD1208 REPLAY local functions ***/
+
+/*******************************************************************/
+static uint8_t _TD1208_REPLAY_parse_record(uint32_t log_size_bytes, uint32_t idx, TD1208_REPLAY_record_t* record) {
+    // Local variables.
+    uint8_t shift = 0;
+    // Header.
+    if (idx >= log_size_bytes) goto errors;
+    record->direction = (uint8_t) (td1208_replay_log[idx] & TD1208_CAPTURE_RECORD_DIRECTION_RX);
+    record->size = (uint8_t) (td1208_replay_log[idx] & TD1208_CAPTURE_RECORD_SIZE_MASK);
+    idx++;
+    // Time since previous record.
+    record->delta_ms = 0;
+    while (1) {
+        if ((idx >= log_size_bytes) || (shift >= (7 * TD1208_CAPTURE_RECORD_TIME_SIZE_BYTES_MAX))) goto errors;
+        record->delta_ms |= ((uint32_t) (td1208_replay_log[idx] & 0x7F)) << shift;
+        shift = (uint8_t) (shift + 7);
+        if ((td1208_replay_log[idx++] & 0x80) == 0) break;
+    }
+    // Data.
+    if ((idx + record->size) > log_size_bytes) goto errors;
+    record->data = &(td1208_replay_log[idx]);
+    record->next_idx = (idx + record->size);
+    return 1;
+errors:
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_REPLAY_starts_with(char_t* str, char_t* prefix, char_t** remainder) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Compare characters.
+    while (prefix[idx] != STRING_CHAR_NULL) {
+        if (str[idx] != prefix[idx]) return 0;
+        idx++;
+    }
+    (*remainder) = &(str[idx]);
+    return 1;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_REPLAY_is_command(char_t* str, char_t* command) {
+    // Local variables.
+    char_t* remainder = NULL;
+    // Exact match.
+    return (uint8_t) ((_TD1208_REPLAY_starts_with(str, command, &remainder) != 0) && (remainder[0] == STRING_CHAR_NULL));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_REPLAY_parse_ul_payload(char_t* str, uint8_t* ul_payload, uint8_t* ul_payload_size_bytes, char_t** remainder) {
+    // Local variables.
+    char_t digits[3] = { STRING_CHAR_NULL };
+    uint8_t idx = 0;
+    // Decode hexadecimal digits until the end of the payload.
+    (*ul_payload_size_bytes) = 0;
+    while ((str[idx] != STRING_CHAR_NULL) && (str[idx] != ',')) {
+        if ((str[idx + 1] == STRING_CHAR_NULL) || ((*ul_payload_size_bytes) >= TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX)) return 0;
+        digits[0] = str[idx];
+        digits[1] = str[idx + 1];
+        ul_payload[(*ul_payload_size_bytes)++] = (uint8_t) strtoul(digits, NULL, 16);
+        idx = (uint8_t) (idx + 2);
+    }
+    (*remainder) = &(str[idx]);
+    return 1;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_REPLAY_parse_repeats(char_t* str, TD1208_tx_options_t* tx_options, char_t** remainder) {
+    // Optional ",<repeats>" argument (full repeats when omitted).
+    tx_options->repeats = TD1208_TX_REPEATS_MAX;
+    if (str[0] == ',') {
+        if ((str[1] < '0') || (str[1] > ('0' + TD1208_TX_REPEATS_MAX))) return 0;
+        tx_options->repeats = (uint8_t) (str[1] - '0');
+        str = &(str[2]);
+    }
+    (*remainder) = str;
+    return 1;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_REPLAY_execute(TD1208_handle_t* handle, TD1208_REPLAY_group_t* group) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_command_t commands[TD1208_REPLAY_BATCH_SIZE_MAX];
+    TD1208_status_t commands_status[TD1208_REPLAY_BATCH_SIZE_MAX];
+    uint8_t ul_payload[TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX];
+    uint8_t ul_payload_size_bytes = 0;
+    uint8_t sigfox_ep_id[TD1208_SIGFOX_EP_ID_SIZE_BYTES];
+    TD1208_module_info_t module_info;
+    TD1208_downlink_t downlink;
+    TD1208_tx_options_t tx_options;
+    char_t* command = group->command[0];
+    char_t* remainder = NULL;
+    uint8_t commands_count = group->commands_count;
+    uint8_t idx = 0;
+    // TX power command is sent by the driver just before the uplink.
+    tx_options.tx_power_enable = 0;
+    tx_options.tx_power_dbm = 0;
+    if ((commands_count == 2) && (_TD1208_REPLAY_starts_with(group->command[1], "AT$S", &remainder) != 0) && (_TD1208_REPLAY_starts_with(command, "ATS302=", &remainder) != 0)) {
+        tx_options.tx_power_enable = 1;
+        tx_options.tx_power_dbm = (uint8_t) strtoul(remainder, NULL, 10);
+        command = group->command[1];
+        commands_count = 1;
+    }
+    // Use the public function which sent the command so that its reply parser is exercised.
+    if (commands_count == 1) {
+        if ((_TD1208_REPLAY_starts_with(command, "ATZ", &remainder) != 0) && (remainder[0] == STRING_CHAR_NULL)) {
+            status = TD1208_instance_reset(handle);
+            goto errors;
+        }
+        if ((_TD1208_REPLAY_starts_with(command, "ATI7", &remainder) != 0) && (remainder[0] == STRING_CHAR_NULL)) {
+            // Force module read.
+            status = TD1208_instance_invalidate_module_info(handle);
+            if (status != TD1208_SUCCESS) goto errors;
+            status = TD1208_instance_get_sigfox_ep_id(handle, sigfox_ep_id);
+            goto errors;
+        }
+        if ((_TD1208_REPLAY_starts_with(command, "AT$SB=", &remainder) != 0) && ((remainder[0] == '0') || (remainder[0] == '1')) && (_TD1208_REPLAY_parse_repeats(&(remainder[1]), &tx_options, &remainder) != 0) && (remainder[0] == STRING_CHAR_NULL)) {
+            status = TD1208_instance_send_bit_with_options(handle, (uint8_t) (command[6] - '0'), &tx_options);
+            goto errors;
+        }
+        if ((_TD1208_REPLAY_starts_with(command, "AT$SF=", &remainder) != 0) && (_TD1208_REPLAY_parse_ul_payload(remainder, ul_payload, &ul_payload_size_bytes, &remainder) != 0) && (_TD1208_REPLAY_parse_repeats(remainder, &tx_options, &remainder) != 0)) {
+            if (remainder[0] == STRING_CHAR_NULL) {
+                status = TD1208_instance_send_frame_with_options(handle, ul_payload, ul_payload_size_bytes, &tx_options);
+                goto errors;
+            }
+            if ((tx_options.repeats == TD1208_TX_REPEATS_MAX) && (tx_options.tx_power_enable == 0) && (_TD1208_REPLAY_starts_with(remainder, ",1", &remainder) != 0) && (remainder[0] == STRING_CHAR_NULL)) {
+                status = TD1208_instance_send_frame_with_downlink(handle, ul_payload, ul_payload_size_bytes, &downlink);
+                goto errors;
+            }
+        }
+    }
+    // Module information queries are sent back to back.
+    if ((commands_count == 3) && (_TD1208_REPLAY_is_command(group->command[0], "ATI7") != 0) && (_TD1208_REPLAY_is_command(group->command[1], "ATI11") != 0) && (_TD1208_REPLAY_is_command(group->command[2], "ATI13") != 0)) {
+        // Force module read.
+        status = TD1208_instance_invalidate_module_info(handle);
+        if (status != TD1208_SUCCESS) goto errors;
+        status = TD1208_instance_get_module_info(handle, &module_info);
+        goto errors;
+    }
+    // Generic commands.
+    for (idx = 0; idx < group->commands_count; idx++) {
+        commands[idx].command = group->command[idx];
+        commands[idx].expected_reply = TD1208_LINE_KIND_OK;
+        commands[idx].timeout_ms = 0;
+    }
+    status = TD1208_instance_execute_batch(handle, commands, group->commands_count, commands_status);
+errors:
+    return status;
+}
+
+/*** TD1208 REPLAY main function ***/
+
+/*******************************************************************/
+int main(int argc, char* argv[]) {
+    // Local variables.
+    static TD1208_SIM_t sim;
+    static TD1208_handle_t handle;
+    TD1208_SIM_configuration_t sim_configuration;
+    TD1208_SIM_statistics_t sim_statistics;
+    TD1208_REPLAY_group_t group;
+    TD1208_REPLAY_record_t record;
+    TD1208_status_t status = TD1208_SUCCESS;
+    FILE* log_file = NULL;
+    uint32_t log_size_bytes = 0;
+    uint32_t idx = 0;
+    uint8_t char_idx = 0;
+    uint32_t groups_count = 0;
+    uint32_t errors_count = 0;
+    uint64_t start_time_us = 0;
+    uint64_t end_time_us = 0;
+    // Parse arguments: capture_file.
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s capture_file\n", argv[0]);
+        return 1;
+    }
+    log_file = fopen(argv[1], "rb");
+    if (log_file == NULL) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    log_size_bytes = (uint32_t) fread(td1208_replay_log, 1, TD1208_REPLAY_LOG_SIZE_BYTES_MAX, log_file);
+    fclose(log_file);
+    // Modem replays the captured replies, the boot sequence is not part of the capture.
+    TD1208_SIM_get_default_configuration(&sim_configuration);
+    sim_configuration.boot_duration_us = 0;
+    sim_configuration.warm_start_enable = 1;
+    sim_configuration.replay_log = td1208_replay_log;
+    sim_configuration.replay_log_size_bytes = log_size_bytes;
+    TD1208_SIM_setup(&sim, &sim_configuration);
+    if (TD1208_instance_init(&handle, &TD1208_SIM_OPS, &sim) != TD1208_SUCCESS) {
+        fprintf(stderr, "TD1208 initialization failed\n");
+        return 1;
+    }
+    // Skip RX records captured before the first command.
+    while ((_TD1208_REPLAY_parse_record(log_size_bytes, idx, &record) != 0) && (record.direction != TD1208_CAPTURE_RECORD_DIRECTION_TX)) {
+        idx = record.next_idx;
+    }
+    // Replay command groups.
+    while (_TD1208_REPLAY_parse_record(log_size_bytes, idx, &record) != 0) {
+        group.commands_count = 0;
+        group.record_idx = idx;
+        group.captured_latency_ms = 0;
+        // Commands sent before the first reply.
+        while ((_TD1208_REPLAY_parse_record(log_size_bytes, idx, &record) != 0) && (record.direction == TD1208_CAPTURE_RECORD_DIRECTION_TX) && (group.commands_count < TD1208_REPLAY_BATCH_SIZE_MAX)) {
+            if (group.commands_count != 0) {
+                group.captured_latency_ms += record.delta_ms;
+            }
+            // Remove the command terminator.
+            for (char_idx = 0; (char_idx < record.size) && (record.data[char_idx] != STRING_CHAR_CR); char_idx++) {
+                group.command[group.commands_count][char_idx] = (char_t) record.data[char_idx];
+            }
+            group.command[group.commands_count][char_idx] = STRING_CHAR_NULL;
+            group.commands_count++;
+            idx = record.next_idx;
+        }
+        // Replies until the next command.
+        while ((_TD1208_REPLAY_parse_record(log_size_bytes, idx, &record) != 0) && (record.direction == TD1208_CAPTURE_RECORD_DIRECTION_RX)) {
+            group.captured_latency_ms += record.delta_ms;
+            idx = record.next_idx;
+        }
+        // Run the driver on the captured replies.
+        TD1208_SIM_get_time(&sim, &start_time_us);
+        status = _TD1208_REPLAY_execute(&handle, &group);
+        TD1208_SIM_get_time(&sim, &end_time_us);
+        if (status != TD1208_SUCCESS) {
+            errors_count++;
+        }
+        groups_count++;
+        printf("{\"record\":%u,\"command\":\"%s\",\"commands\":%u,\"status\":%d,\"captured_latency_ms\":%u,\"replay_latency_ms\":%u}\n",
+            (unsigned int) group.record_idx, group.command[0], (unsigned int) group.commands_count, (int) status,
+            (unsigned int) group.captured_latency_ms, (unsigned int) ((end_time_us - start_time_us) / 1000));
+    }
+    // Summary.
+    TD1208_SIM_get_statistics(&sim, &sim_statistics);
+    printf("{\"groups\":%u,\"errors\":%u,\"mismatches\":%u,\"log_size_bytes\":%u}\n", (unsigned int) groups_count, (unsigned int) errors_count, (unsigned int) sim_statistics.replay_mismatch_count, (unsigned int) log_size_bytes);
+    TD1208_instance_de_init(&handle);
+    return 0;
+}
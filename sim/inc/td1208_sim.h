@@ -0,0 +1,179 @@
+/*
+ * td1208_sim.h
+ *
+ *  Created on: 02 jan. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TD1208_SIM_H__
+#define __TD1208_SIM_H__
+
+#ifndef TD1208_DRIVER_DISABLE_FLAGS_FILE
+#include "td1208_driver_flags.h"
+#endif
+#include "td1208.h"
+#include "td1208_hw.h"
+#include "types.h"
+
+#ifndef TD1208_DRIVER_DISABLE
+
+/*** TD1208 SIM macros ***/
+
+#define TD1208_SIM_COMMAND_SIZE_MAX         64
+#define TD1208_SIM_OUTPUT_BUFFER_SIZE       256
+
+/*** TD1208 SIM structures ***/
+
+/*!******************************************************************
+ * \struct TD1208_SIM_configuration_t
+ * \brief TD1208 modem emulator parameters.
+ *******************************************************************/
+typedef struct {
+    // Module identity.
+    uint8_t sigfox_ep_id[TD1208_SIGFOX_EP_ID_SIZE_BYTES];
+    char_t* hardware_revision;
+    char_t* firmware_revision;
+    uint32_t modem_baud_rate;
+    uint8_t echo_enable;
+    // Timings (commands are ignored during boot, uplink duration is given for TD1208_TX_REPEATS_MAX repeats).
+    uint32_t boot_duration_us;
+    uint32_t command_latency_us;
+    uint32_t reset_latency_us;
+    uint32_t uplink_duration_us;
+    uint32_t latency_jitter_us;
+    // Downlink (RX line and closing line sent after downlink_delay_us when requested and enabled).
+    uint8_t downlink_enable;
+    uint8_t dl_payload[TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES];
+    int16_t downlink_rssi_dbm;
+    uint32_t downlink_delay_us;
+    // Replies fragmentation (disabled when fragment_size_max is 0).
+    uint8_t fragment_size_max;
+    uint32_t fragment_gap_us;
+    // Faults injection.
+    uint16_t noise_probability_permille;
+    uint16_t error_probability_permille;
+    uint32_t random_seed;
+    // ATS302 is rejected above this power.
+    uint8_t tx_power_max_dbm;
+    // Module stays powered between de-init and init (reported to the driver).
+    uint8_t warm_start_enable;
+    // Capture log replay (replies are the RX records following each TX record instead of being emulated, NULL to disable).
+    const uint8_t* replay_log;
+    uint32_t replay_log_size_bytes;
+} TD1208_SIM_configuration_t;
+
+/*!******************************************************************
+ * \struct TD1208_SIM_statistics_t
+ * \brief TD1208 modem emulator counters.
+ *******************************************************************/
+typedef struct {
+    uint32_t commands_count;
+    uint32_t tx_bytes_count;
+    uint32_t rx_bytes_count;
+    uint32_t noise_lines_count;
+    uint32_t error_replies_count;
+    uint32_t downlink_frames_count;
+    uint32_t uplink_frames_count;
+    uint32_t sleep_time_ms;
+    uint32_t dropped_bytes_count;
+    uint32_t replay_mismatch_count;
+} TD1208_SIM_statistics_t;
+
+/*!******************************************************************
+ * \struct TD1208_SIM_output_byte_t
+ * \brief Byte scheduled on the modem TX line.
+ *******************************************************************/
+typedef struct {
+    uint64_t time_us;
+    char_t data;
+} TD1208_SIM_output_byte_t;
+
+/*!******************************************************************
+ * \struct TD1208_SIM_t
+ * \brief TD1208 modem emulator instance (hardware context of the driver instance).
+ *******************************************************************/
+typedef struct {
+    TD1208_SIM_configuration_t configuration;
+    TD1208_HW_configuration_t hw_configuration;
+    uint8_t initialized;
+    uint8_t booted;
+    uint64_t boot_end_time_us;
+    uint32_t host_baud_rate;
+    uint32_t modem_baud_rate;
+    // Virtual clock.
+    uint64_t time_us;
+    uint32_t random_state;
+    volatile uint8_t event;
+    // Command being received.
+    char_t command[TD1208_SIM_COMMAND_SIZE_MAX];
+    uint8_t command_size;
+    uint8_t command_overflow;
+    // Scheduled replies.
+    TD1208_SIM_output_byte_t output[TD1208_SIM_OUTPUT_BUFFER_SIZE];
+    uint16_t output_head_idx;
+    uint16_t output_count;
+    uint64_t output_end_time_us;
+    uint8_t fragment_remaining;
+    uint32_t replay_idx;
+    // Radio configuration.
+    uint8_t tx_power_dbm;
+    TD1208_SIM_statistics_t statistics;
+} TD1208_SIM_t;
+
+/*** TD1208 SIM global variables ***/
+
+// Operations table to give to TD1208_instance_init() with a TD1208_SIM_t pointer as hardware context.
+extern const TD1208_HW_ops_t TD1208_SIM_OPS;
+
+/*** TD1208 SIM functions ***/
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_SIM_get_default_configuration(TD1208_SIM_configuration_t* configuration)
+ * \brief Get the default emulator parameters (nominal timings, no fragmentation and no fault).
+ * \param[in]   none
+ * \param[out]  configuration: Pointer to the parameters structure to fill.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_SIM_get_default_configuration(TD1208_SIM_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_SIM_setup(TD1208_SIM_t* sim, TD1208_SIM_configuration_t* configuration)
+ * \brief Setup a modem emulator (to be called before TD1208_instance_init()).
+ * \param[in]   sim: Pointer to the emulator instance.
+ * \param[in]   configuration: Pointer to the emulator parameters.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_SIM_setup(TD1208_SIM_t* sim, TD1208_SIM_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_SIM_advance(TD1208_SIM_t* sim, uint32_t duration_us)
+ * \brief Advance the virtual clock and deliver the replies which are due (to be called before TD1208_instance_process() in asynchronous mode).
+ * \param[in]   sim: Pointer to the emulator instance.
+ * \param[in]   duration_us: Virtual time to elapse in us.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_SIM_advance(TD1208_SIM_t* sim, uint32_t duration_us);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_SIM_get_time(TD1208_SIM_t* sim, uint64_t* time_us)
+ * \brief Read the virtual clock.
+ * \param[in]   sim: Pointer to the emulator instance.
+ * \param[out]  time_us: Pointer to the virtual time in us since setup.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_SIM_get_time(TD1208_SIM_t* sim, uint64_t* time_us);
+
+/*!******************************************************************
+ * \fn TD1208_status_t TD1208_SIM_get_statistics(TD1208_SIM_t* sim, TD1208_SIM_statistics_t* statistics)
+ * \brief Read the emulator counters.
+ * \param[in]   sim: Pointer to the emulator instance.
+ * \param[out]  statistics: Pointer to the counters structure to fill.
+ * \retval      Function execution status.
+ *******************************************************************/
+TD1208_status_t TD1208_SIM_get_statistics(TD1208_SIM_t* sim, TD1208_SIM_statistics_t* statistics);
+
+#endif /* TD1208_DRIVER_DISABLE */
+
+#endif /* __TD1208_SIM_H__ */
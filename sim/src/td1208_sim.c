@@ -0,0 +1,840 @@
+/*
+ * td1208_sim.c
+ *
+ *  Created on: 02 jan. 2026
+ *      Author: Ludo
+ */
+
+#include "td1208_sim.h"
+
+#ifndef TD1208_DRIVER_DISABLE_FLAGS_FILE
+#include "td1208_driver_flags.h"
+#endif
+#include "strings.h"
+#include "td1208.h"
+#include "td1208_hw.h"
+#include "types.h"
+
+#ifndef TD1208_DRIVER_DISABLE
+
+/*** TD1208 SIM local macros ***/
+
+#define TD1208_SIM_DEFAULT_BAUD_RATE            9600
+#define TD1208_SIM_UART_BITS_PER_BYTE           10
+
+#define TD1208_SIM_DEFAULT_BOOT_DURATION_US     200000
+#define TD1208_SIM_DEFAULT_COMMAND_LATENCY_US   5000
+#define TD1208_SIM_DEFAULT_RESET_LATENCY_US     100000
+#define TD1208_SIM_DEFAULT_UPLINK_DURATION_US   6000000
+#define TD1208_SIM_DEFAULT_DOWNLINK_DELAY_US    20000000
+#define TD1208_SIM_DEFAULT_DOWNLINK_RSSI_DBM    (-110)
+
+#define TD1208_SIM_DOWNLINK_REPLY_SIZE_MAX      48
+
+#define TD1208_SIM_NOISE_LINE_SIZE_MAX          8
+
+#define TD1208_SIM_REPLY_OK                     "OK\r\n"
+#define TD1208_SIM_REPLY_ERROR                  "ERROR\r\n"
+#define TD1208_SIM_REPLY_END_OF_LINE            "\r\n"
+#define TD1208_SIM_REPLY_DOWNLINK_END           "+RX END\r\n"
+
+/*** TD1208 SIM local functions ***/
+
+/*******************************************************************/
+static uint32_t _TD1208_SIM_random(TD1208_SIM_t* sim) {
+    // Xorshift generator (reproducible runs for a given seed).
+    sim->random_state ^= (sim->random_state << 13);
+    sim->random_state ^= (sim->random_state >> 17);
+    sim->random_state ^= (sim->random_state << 5);
+    return (sim->random_state);
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_SIM_random_range(TD1208_SIM_t* sim, uint32_t maximum) {
+    return ((maximum == 0) ? 0 : (_TD1208_SIM_random(sim) % (maximum + 1)));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_random_event(TD1208_SIM_t* sim, uint16_t probability_permille) {
+    return ((probability_permille == 0) ? 0 : ((_TD1208_SIM_random(sim) % 1000) < probability_permille));
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_SIM_byte_time_us(uint32_t baud_rate) {
+    return ((baud_rate == 0) ? 0 : ((TD1208_SIM_UART_BITS_PER_BYTE * 1000000) / baud_rate));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_is_hexadecimal(char_t character) {
+    // Check character range.
+    return (((character >= '0') && (character <= '9')) || ((character >= 'A') && (character <= 'F')) || ((character >= 'a') && (character <= 'f')));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_starts_with(char_t* str, char_t* prefix) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Compare characters.
+    while (prefix[idx] != STRING_CHAR_NULL) {
+        if (str[idx] != prefix[idx]) {
+            return 0;
+        }
+        idx++;
+    }
+    return 1;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_equals(char_t* str, char_t* reference) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Compare characters.
+    while (reference[idx] != STRING_CHAR_NULL) {
+        if (str[idx] != reference[idx]) {
+            return 0;
+        }
+        idx++;
+    }
+    return (str[idx] == STRING_CHAR_NULL);
+}
+
+#ifndef TD1208_DRIVER_RX_BLOCK_MODE
+/*******************************************************************/
+static void _TD1208_SIM_rx_byte(TD1208_SIM_t* sim, char_t data) {
+    // Call the driver instance callback first.
+    if (sim->hw_configuration.instance_rx_irq_callback != NULL) {
+        sim->hw_configuration.instance_rx_irq_callback(sim->hw_configuration.handle, (uint8_t) data);
+    }
+    else if (sim->hw_configuration.rx_irq_callback != NULL) {
+        sim->hw_configuration.rx_irq_callback((uint8_t) data);
+    }
+}
+#endif
+
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+/*******************************************************************/
+static void _TD1208_SIM_rx_block(TD1208_SIM_t* sim, uint32_t data_size_bytes) {
+    // Call the driver instance callback first.
+    if (sim->hw_configuration.instance_rx_block_callback != NULL) {
+        sim->hw_configuration.instance_rx_block_callback(sim->hw_configuration.handle, sim->hw_configuration.rx_block_buffer, data_size_bytes);
+    }
+    else if (sim->hw_configuration.rx_block_callback != NULL) {
+        sim->hw_configuration.rx_block_callback(sim->hw_configuration.rx_block_buffer, data_size_bytes);
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _TD1208_SIM_deliver(TD1208_SIM_t* sim, uint64_t time_us) {
+    // Local variables.
+    TD1208_SIM_output_byte_t* output_byte = NULL;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    uint32_t block_size = 0;
+#endif
+    // Deliver all bytes which are due.
+    while (sim->output_count > 0) {
+        output_byte = &(sim->output[sim->output_head_idx]);
+        if (output_byte->time_us > time_us) break;
+        sim->time_us = output_byte->time_us;
+        sim->statistics.rx_bytes_count++;
+        if (sim->initialized != 0) {
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+            // Emulate DMA transfer until the line becomes idle or the buffer is full.
+            sim->hw_configuration.rx_block_buffer[block_size++] = (uint8_t) (output_byte->data);
+            if (block_size >= sim->hw_configuration.rx_block_buffer_size_bytes) {
+                _TD1208_SIM_rx_block(sim, block_size);
+                block_size = 0;
+            }
+#else
+            _TD1208_SIM_rx_byte(sim, output_byte->data);
+#endif
+        }
+        sim->output_head_idx = (uint16_t) ((sim->output_head_idx + 1) % TD1208_SIM_OUTPUT_BUFFER_SIZE);
+        sim->output_count--;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+        // Idle line event at the end of each fragment.
+        if ((block_size > 0) && ((sim->output_count == 0) || (sim->output[sim->output_head_idx].time_us > (sim->time_us + _TD1208_SIM_byte_time_us(sim->host_baud_rate))))) {
+            _TD1208_SIM_rx_block(sim, block_size);
+            block_size = 0;
+        }
+#endif
+    }
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    if (block_size > 0) {
+        _TD1208_SIM_rx_block(sim, block_size);
+    }
+#endif
+    if (time_us > sim->time_us) {
+        sim->time_us = time_us;
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_schedule(TD1208_SIM_t* sim, char_t* str, uint32_t delay_us) {
+    // Local variables.
+    uint32_t byte_time_us = _TD1208_SIM_byte_time_us(sim->modem_baud_rate);
+    uint64_t time_us = (sim->time_us + delay_us);
+    uint16_t idx = 0;
+    // Replies are sent in order.
+    if (time_us < sim->output_end_time_us) {
+        time_us = sim->output_end_time_us;
+    }
+    while (str[idx] != STRING_CHAR_NULL) {
+        // Split reply in fragments.
+        if (sim->configuration.fragment_size_max != 0) {
+            if (sim->fragment_remaining == 0) {
+                sim->fragment_remaining = (uint8_t) (1 + _TD1208_SIM_random_range(sim, (uint32_t) (sim->configuration.fragment_size_max - 1)));
+                time_us += sim->configuration.fragment_gap_us;
+            }
+            sim->fragment_remaining--;
+        }
+        time_us += byte_time_us;
+        if (sim->output_count < TD1208_SIM_OUTPUT_BUFFER_SIZE) {
+            sim->output[(sim->output_head_idx + sim->output_count) % TD1208_SIM_OUTPUT_BUFFER_SIZE].time_us = time_us;
+            sim->output[(sim->output_head_idx + sim->output_count) % TD1208_SIM_OUTPUT_BUFFER_SIZE].data = str[idx];
+            sim->output_count++;
+        }
+        else {
+            sim->statistics.dropped_bytes_count++;
+        }
+        idx++;
+    }
+    sim->output_end_time_us = time_us;
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_schedule_noise(TD1208_SIM_t* sim) {
+    // Local variables.
+    char_t noise[TD1208_SIM_NOISE_LINE_SIZE_MAX + sizeof(TD1208_SIM_REPLY_END_OF_LINE)];
+    uint8_t noise_size = (uint8_t) (1 + _TD1208_SIM_random_range(sim, (TD1208_SIM_NOISE_LINE_SIZE_MAX - 1)));
+    uint8_t idx = 0;
+    // Use non hexadecimal characters so that the line is classified as unsolicited.
+    for (idx = 0; idx < noise_size; idx++) {
+        noise[idx] = (char_t) ('G' + _TD1208_SIM_random_range(sim, ('Z' - 'G')));
+    }
+    noise[idx++] = STRING_CHAR_CR;
+    noise[idx++] = STRING_CHAR_LF;
+    noise[idx] = STRING_CHAR_NULL;
+    _TD1208_SIM_schedule(sim, noise, _TD1208_SIM_random_range(sim, sim->configuration.command_latency_us));
+    sim->statistics.noise_lines_count++;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_parse_uplink_options(char_t* options, uint8_t* repeats, uint8_t* downlink_request) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Optional ",<repeats>[,<downlink request>]" suffix (the module sends all repetitions by default).
+    (*repeats) = TD1208_TX_REPEATS_MAX;
+    (*downlink_request) = 0;
+    if (options[idx] == ',') {
+        if ((options[idx + 1] < '0') || (options[idx + 1] > ('0' + TD1208_TX_REPEATS_MAX))) {
+            return 0;
+        }
+        (*repeats) = (uint8_t) (options[idx + 1] - '0');
+        idx += 2;
+        if (options[idx] == ',') {
+            if ((options[idx + 1] != '0') && (options[idx + 1] != '1')) {
+                return 0;
+            }
+            (*downlink_request) = (uint8_t) (options[idx + 1] - '0');
+            idx += 2;
+        }
+    }
+    return (options[idx] == STRING_CHAR_NULL);
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_check_uplink_payload(char_t* payload, uint8_t* repeats, uint8_t* downlink_request) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Check characters.
+    while ((payload[idx] != STRING_CHAR_NULL) && (payload[idx] != ',')) {
+        if (_TD1208_SIM_is_hexadecimal(payload[idx]) == 0) {
+            return 0;
+        }
+        idx++;
+    }
+    if (((idx % 2) != 0) || (idx > (TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX * 2))) {
+        return 0;
+    }
+    return _TD1208_SIM_parse_uplink_options(&(payload[idx]), repeats, downlink_request);
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_SIM_start_uplink(TD1208_SIM_t* sim, uint8_t repeats) {
+    // Radio time is proportional to the number of frames.
+    sim->statistics.uplink_frames_count += (uint32_t) (repeats + 1);
+    return (uint32_t) (((uint64_t) sim->configuration.uplink_duration_us * (repeats + 1)) / (TD1208_TX_REPEATS_MAX + 1));
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_schedule_downlink(TD1208_SIM_t* sim, uint32_t delay_us) {
+    // Local variables.
+    char_t reply[TD1208_SIM_DOWNLINK_REPLY_SIZE_MAX];
+    uint16_t rssi_abs = 0;
+    uint8_t reply_size = 0;
+    uint8_t idx = 0;
+    // Format: RX=XX XX XX XX XX XX XX XX,<RSSI> followed by +RX END.
+    reply[reply_size++] = 'R';
+    reply[reply_size++] = 'X';
+    reply[reply_size++] = '=';
+    for (idx = 0; idx < TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES; idx++) {
+        if (idx != 0) {
+            reply[reply_size++] = STRING_CHAR_SPACE;
+        }
+        STRING_byte_array_to_hexadecimal_string(&(sim->configuration.dl_payload[idx]), 1, 0, &(reply[reply_size]));
+        reply_size += 2;
+    }
+    reply[reply_size++] = ',';
+    rssi_abs = (uint16_t) ((sim->configuration.downlink_rssi_dbm < 0) ? (-sim->configuration.downlink_rssi_dbm) : sim->configuration.downlink_rssi_dbm);
+    if (sim->configuration.downlink_rssi_dbm < 0) {
+        reply[reply_size++] = STRING_CHAR_MINUS;
+    }
+    if (rssi_abs >= 100) {
+        reply[reply_size++] = (char_t) ('0' + ((rssi_abs / 100) % 10));
+    }
+    if (rssi_abs >= 10) {
+        reply[reply_size++] = (char_t) ('0' + ((rssi_abs / 10) % 10));
+    }
+    reply[reply_size++] = (char_t) ('0' + (rssi_abs % 10));
+    reply[reply_size++] = STRING_CHAR_CR;
+    reply[reply_size++] = STRING_CHAR_LF;
+    reply[reply_size] = STRING_CHAR_NULL;
+    _TD1208_SIM_schedule(sim, reply, delay_us);
+    // The exchange ends with a closing line.
+    _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_DOWNLINK_END, 0);
+    sim->statistics.downlink_frames_count++;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_parse_baud_rate(char_t* value, uint32_t* baud_rate) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Parse decimal value.
+    (*baud_rate) = 0;
+    while (value[idx] != STRING_CHAR_NULL) {
+        if ((value[idx] < '0') || (value[idx] > '9')) {
+            return 0;
+        }
+        (*baud_rate) = ((*baud_rate) * 10) + (uint32_t) (value[idx] - '0');
+        idx++;
+    }
+    return ((idx != 0) && ((*baud_rate) != 0));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_SIM_parse_tx_power(char_t* value, uint8_t tx_power_max_dbm, uint8_t* tx_power_dbm) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Parse decimal value (at most 2 digits).
+    (*tx_power_dbm) = 0;
+    while ((value[idx] != STRING_CHAR_NULL) && (idx < 2)) {
+        if ((value[idx] < '0') || (value[idx] > '9')) {
+            return 0;
+        }
+        (*tx_power_dbm) = (uint8_t) (((*tx_power_dbm) * 10) + (value[idx] - '0'));
+        idx++;
+    }
+    return ((idx != 0) && (value[idx] == STRING_CHAR_NULL) && ((*tx_power_dbm) <= tx_power_max_dbm));
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_replay(TD1208_SIM_t* sim) {
+    // Local variables.
+    const uint8_t* log = sim->configuration.replay_log;
+    char_t chunk[TD1208_CAPTURE_RECORD_SIZE_MASK + 1];
+    // The TX record is timestamped before the command transmission.
+    uint64_t command_time_us = (uint64_t) (sim->command_size + 1) * _TD1208_SIM_byte_time_us(sim->host_baud_rate);
+    uint64_t offset_us = 0;
+    uint64_t chunk_time_us = 0;
+    uint32_t delta_ms = 0;
+    uint32_t idx = 0;
+    uint8_t header = 0;
+    uint8_t size = 0;
+    uint8_t shift = 0;
+    uint8_t command_found = 0;
+    uint8_t byte_idx = 0;
+    // Play the RX records which follow the next TX record.
+    while (sim->replay_idx < sim->configuration.replay_log_size_bytes) {
+        // Parse record.
+        idx = sim->replay_idx;
+        header = log[idx++];
+        size = (uint8_t) (header & TD1208_CAPTURE_RECORD_SIZE_MASK);
+        delta_ms = 0;
+        shift = 0;
+        while ((idx < sim->configuration.replay_log_size_bytes) && (shift < (7 * TD1208_CAPTURE_RECORD_TIME_SIZE_BYTES_MAX))) {
+            delta_ms |= ((uint32_t) (log[idx] & 0x7F)) << shift;
+            shift = (uint8_t) (shift + 7);
+            if ((log[idx++] & 0x80) == 0) break;
+        }
+        if ((idx + size) > sim->configuration.replay_log_size_bytes) {
+            // Truncated log.
+            sim->replay_idx = sim->configuration.replay_log_size_bytes;
+            break;
+        }
+        if ((header & TD1208_CAPTURE_RECORD_DIRECTION_RX) == 0) {
+            // Stop at the following command.
+            if (command_found != 0) break;
+            command_found = 1;
+            // Check that the driver sent the captured command.
+            if ((size != (sim->command_size + 1)) || (log[idx + sim->command_size] != STRING_CHAR_CR)) {
+                sim->statistics.replay_mismatch_count++;
+            }
+            else {
+                for (byte_idx = 0; byte_idx < sim->command_size; byte_idx++) {
+                    if (log[idx + byte_idx] != (uint8_t) sim->command[byte_idx]) {
+                        sim->statistics.replay_mismatch_count++;
+                        break;
+                    }
+                }
+            }
+        }
+        else if (command_found != 0) {
+            // Schedule chunk so that its last byte is received at the captured time.
+            offset_us += ((uint64_t) delta_ms * 1000);
+            for (byte_idx = 0; byte_idx < size; byte_idx++) {
+                chunk[byte_idx] = (char_t) log[idx + byte_idx];
+            }
+            chunk[size] = STRING_CHAR_NULL;
+            chunk_time_us = command_time_us + ((uint64_t) size * _TD1208_SIM_byte_time_us(sim->modem_baud_rate));
+            _TD1208_SIM_schedule(sim, chunk, (uint32_t) ((offset_us > chunk_time_us) ? (offset_us - chunk_time_us) : 0));
+        }
+        sim->replay_idx = (idx + size);
+    }
+    // No more command in the log.
+    if (command_found == 0) {
+        sim->statistics.replay_mismatch_count++;
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_execute(TD1208_SIM_t* sim) {
+    // Local variables.
+    char_t* command = sim->command;
+    char_t reply[TD1208_MODULE_INFO_REVISION_SIZE_CHAR + sizeof(TD1208_SIM_REPLY_END_OF_LINE) + sizeof(TD1208_SIM_REPLY_OK)];
+    uint32_t latency_us = sim->configuration.command_latency_us + _TD1208_SIM_random_range(sim, sim->configuration.latency_jitter_us);
+    uint32_t baud_rate = 0;
+    uint8_t downlink_request = 0;
+    uint8_t repeats = 0;
+    uint32_t uplink_duration_us = 0;
+    uint8_t tx_power_dbm = 0;
+    char_t* text = NULL;
+    uint8_t idx = 0;
+    uint8_t reply_size = 0;
+    // Ignore empty lines.
+    if (sim->command_size == 0) goto end;
+    sim->statistics.commands_count++;
+    // Captured replies.
+    if (sim->configuration.replay_log != NULL) {
+        _TD1208_SIM_replay(sim);
+        goto end;
+    }
+    // Echo.
+    if (sim->configuration.echo_enable != 0) {
+        _TD1208_SIM_schedule(sim, command, 0);
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_END_OF_LINE, 0);
+    }
+    // Injected faults.
+    if (_TD1208_SIM_random_event(sim, sim->configuration.noise_probability_permille) != 0) {
+        _TD1208_SIM_schedule_noise(sim);
+    }
+    if ((sim->command_overflow != 0) || (_TD1208_SIM_random_event(sim, sim->configuration.error_probability_permille) != 0)) {
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_ERROR, latency_us);
+        sim->statistics.error_replies_count++;
+        goto end;
+    }
+    // Commands.
+    if ((_TD1208_SIM_equals(command, "AT") != 0) || (_TD1208_SIM_equals(command, "ATE0") != 0)) {
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, latency_us);
+    }
+    else if (_TD1208_SIM_equals(command, "ATZ") != 0) {
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, (latency_us + sim->configuration.reset_latency_us));
+        sim->tx_power_dbm = TD1208_TX_POWER_DBM_MAX;
+    }
+    else if (_TD1208_SIM_equals(command, "ATI7") != 0) {
+        // Sigfox EP ID.
+        STRING_byte_array_to_hexadecimal_string(sim->configuration.sigfox_ep_id, TD1208_SIGFOX_EP_ID_SIZE_BYTES, 0, reply);
+        reply_size = (TD1208_SIGFOX_EP_ID_SIZE_BYTES * 2);
+        reply[reply_size++] = STRING_CHAR_CR;
+        reply[reply_size++] = STRING_CHAR_LF;
+        reply[reply_size] = STRING_CHAR_NULL;
+        _TD1208_SIM_schedule(sim, reply, latency_us);
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, 0);
+    }
+    else if ((_TD1208_SIM_equals(command, "ATI11") != 0) || (_TD1208_SIM_equals(command, "ATI13") != 0)) {
+        // Module revisions.
+        text = (command[4] == '1') ? sim->configuration.hardware_revision : sim->configuration.firmware_revision;
+        for (idx = 0; (text != NULL) && (text[idx] != STRING_CHAR_NULL) && (idx < TD1208_MODULE_INFO_REVISION_SIZE_CHAR); idx++) {
+            reply[reply_size++] = text[idx];
+        }
+        reply[reply_size++] = STRING_CHAR_CR;
+        reply[reply_size++] = STRING_CHAR_LF;
+        reply[reply_size] = STRING_CHAR_NULL;
+        _TD1208_SIM_schedule(sim, reply, latency_us);
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, 0);
+    }
+    else if ((_TD1208_SIM_starts_with(command, "AT$SF=") != 0) && (_TD1208_SIM_check_uplink_payload(&(command[6]), &repeats, &downlink_request) != 0)) {
+        uplink_duration_us = _TD1208_SIM_start_uplink(sim, repeats);
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, (latency_us + uplink_duration_us));
+        if ((downlink_request != 0) && (sim->configuration.downlink_enable != 0)) {
+            _TD1208_SIM_schedule_downlink(sim, (latency_us + uplink_duration_us + sim->configuration.downlink_delay_us));
+        }
+    }
+    else if ((_TD1208_SIM_starts_with(command, "AT$SB=") != 0) && ((command[6] == '0') || (command[6] == '1')) && (_TD1208_SIM_parse_uplink_options(&(command[7]), &repeats, &downlink_request) != 0)) {
+        uplink_duration_us = _TD1208_SIM_start_uplink(sim, repeats);
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, (latency_us + uplink_duration_us));
+    }
+    else if ((_TD1208_SIM_starts_with(command, "ATS302=") != 0) && (_TD1208_SIM_parse_tx_power(&(command[7]), sim->configuration.tx_power_max_dbm, &tx_power_dbm) != 0)) {
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, latency_us);
+        sim->tx_power_dbm = tx_power_dbm;
+    }
+    else if ((_TD1208_SIM_starts_with(command, "AT+IPR=") != 0) && (_TD1208_SIM_parse_baud_rate(&(command[7]), &baud_rate) != 0)) {
+        // Reply is sent with the current baud rate, then the modem switches to the new one.
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_OK, latency_us);
+        sim->modem_baud_rate = baud_rate;
+    }
+    else {
+        _TD1208_SIM_schedule(sim, TD1208_SIM_REPLY_ERROR, latency_us);
+    }
+end:
+    sim->command_size = 0;
+    sim->command_overflow = 0;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_init(void* hw_context, TD1208_HW_configuration_t* configuration) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Check parameters.
+    if ((sim == NULL) || (configuration == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    sim->hw_configuration = (*configuration);
+    sim->host_baud_rate = (configuration->uart_baud_rate);
+    sim->command_size = 0;
+    sim->command_overflow = 0;
+    sim->event = 0;
+    // Power cycle the module unless warm start is enabled.
+    if ((sim->booted == 0) || (sim->configuration.warm_start_enable == 0)) {
+        sim->boot_end_time_us = sim->time_us + sim->configuration.boot_duration_us;
+        sim->booted = 1;
+    }
+    sim->initialized = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_de_init(void* hw_context) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Check parameter.
+    if (sim == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    sim->initialized = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_uart_write(void* hw_context, uint8_t* data, uint32_t data_size_bytes) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    uint32_t byte_time_us = 0;
+    uint32_t idx = 0;
+    // Check parameters.
+    if ((sim == NULL) || (data == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    byte_time_us = _TD1208_SIM_byte_time_us(sim->host_baud_rate);
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        // Transmission time.
+        _TD1208_SIM_deliver(sim, (sim->time_us + byte_time_us));
+        sim->statistics.tx_bytes_count++;
+        // Bytes are not understood by the modem during boot or when baud rates differ.
+        if ((sim->time_us < sim->boot_end_time_us) || (sim->host_baud_rate != sim->modem_baud_rate)) continue;
+        if (data[idx] == STRING_CHAR_CR) {
+            sim->command[sim->command_size] = STRING_CHAR_NULL;
+            _TD1208_SIM_execute(sim);
+        }
+        else if (data[idx] != STRING_CHAR_LF) {
+            if (sim->command_size < (TD1208_SIM_COMMAND_SIZE_MAX - 1)) {
+                sim->command[sim->command_size++] = (char_t) data[idx];
+            }
+            else {
+                sim->command_overflow = 1;
+            }
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_uart_write_vector(void* hw_context, TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (buffers == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    for (idx = 0; idx < buffers_count; idx++) {
+        status = _TD1208_SIM_uart_write(hw_context, buffers[idx].data, buffers[idx].size_bytes);
+        if (status != TD1208_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_set_baud_rate(void* hw_context, uint32_t baud_rate) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Check parameter.
+    if (sim == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    sim->host_baud_rate = baud_rate;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_delay_milliseconds(void* hw_context, uint32_t delay_ms) {
+    // Advance virtual clock.
+    return TD1208_SIM_advance((TD1208_SIM_t*) hw_context, (delay_ms * 1000));
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_wait_event(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    uint64_t start_time_us = 0;
+    uint64_t end_time_us = 0;
+    uint64_t next_time_us = 0;
+    // Check parameters.
+    if ((sim == NULL) || (elapsed_ms == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    start_time_us = sim->time_us;
+    end_time_us = start_time_us + ((uint64_t) timeout_ms * 1000);
+    // Jump from one scheduled byte to the next one until a line is signaled.
+    while ((sim->event == 0) && (sim->time_us < end_time_us)) {
+        next_time_us = end_time_us;
+        if ((sim->output_count > 0) && (sim->output[sim->output_head_idx].time_us < end_time_us)) {
+            next_time_us = sim->output[sim->output_head_idx].time_us;
+        }
+        _TD1208_SIM_deliver(sim, next_time_us);
+    }
+    sim->event = 0;
+    // Round elapsed time to the upper millisecond.
+    (*elapsed_ms) = (uint32_t) ((sim->time_us - start_time_us + 999) / 1000);
+    _TD1208_SIM_deliver(sim, (start_time_us + ((uint64_t) (*elapsed_ms) * 1000)));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_sleep_until_event(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Low power mode behaves as an event wait on the virtual clock.
+    status = _TD1208_SIM_wait_event(hw_context, timeout_ms, elapsed_ms);
+    if (status != TD1208_SUCCESS) goto errors;
+    ((TD1208_SIM_t*) hw_context)->statistics.sleep_time_ms += (*elapsed_ms);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_get_power_state(void* hw_context, uint8_t* module_powered) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Check parameters.
+    if ((sim == NULL) || (module_powered == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Module is ready when the boot has already been completed.
+    (*module_powered) = ((sim->configuration.warm_start_enable != 0) && (sim->time_us >= sim->boot_end_time_us)) ? 1 : 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _TD1208_SIM_signal_event(void* hw_context) {
+    // Local variables.
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Set flag.
+    if (sim != NULL) {
+        sim->event = 1;
+    }
+}
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+static TD1208_status_t _TD1208_SIM_get_time_ms(void* hw_context, uint32_t* time_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_t* sim = (TD1208_SIM_t*) hw_context;
+    // Check parameters.
+    if ((sim == NULL) || (time_ms == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*time_ms) = (uint32_t) (sim->time_us / 1000);
+errors:
+    return status;
+}
+#endif
+
+/*** TD1208 SIM global variables ***/
+
+const TD1208_HW_ops_t TD1208_SIM_OPS = {
+    .init = &_TD1208_SIM_init,
+    .de_init = &_TD1208_SIM_de_init,
+    .uart_write = &_TD1208_SIM_uart_write,
+    .uart_write_vector = &_TD1208_SIM_uart_write_vector,
+    .set_baud_rate = &_TD1208_SIM_set_baud_rate,
+    .delay_milliseconds = &_TD1208_SIM_delay_milliseconds,
+    .wait_event = &_TD1208_SIM_wait_event,
+    .signal_event = &_TD1208_SIM_signal_event,
+    .sleep_until_event = &_TD1208_SIM_sleep_until_event,
+    .get_power_state = &_TD1208_SIM_get_power_state,
+#ifdef TD1208_DRIVER_CAPTURE
+    .get_time_ms = &_TD1208_SIM_get_time_ms
+#endif
+};
+
+/*** TD1208 SIM functions ***/
+
+/*******************************************************************/
+TD1208_status_t TD1208_SIM_get_default_configuration(TD1208_SIM_configuration_t* configuration) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (configuration == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    for (idx = 0; idx < TD1208_SIGFOX_EP_ID_SIZE_BYTES; idx++) {
+        configuration->sigfox_ep_id[idx] = (uint8_t) (0x10 + idx);
+    }
+    configuration->hardware_revision = "TD1208 SIM HW";
+    configuration->firmware_revision = "TD1208 SIM FW";
+    configuration->modem_baud_rate = TD1208_SIM_DEFAULT_BAUD_RATE;
+    configuration->echo_enable = 0;
+    configuration->boot_duration_us = TD1208_SIM_DEFAULT_BOOT_DURATION_US;
+    configuration->command_latency_us = TD1208_SIM_DEFAULT_COMMAND_LATENCY_US;
+    configuration->reset_latency_us = TD1208_SIM_DEFAULT_RESET_LATENCY_US;
+    configuration->uplink_duration_us = TD1208_SIM_DEFAULT_UPLINK_DURATION_US;
+    configuration->latency_jitter_us = 0;
+    configuration->downlink_enable = 1;
+    for (idx = 0; idx < TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES; idx++) {
+        configuration->dl_payload[idx] = (uint8_t) (0xD0 + idx);
+    }
+    configuration->downlink_rssi_dbm = TD1208_SIM_DEFAULT_DOWNLINK_RSSI_DBM;
+    configuration->downlink_delay_us = TD1208_SIM_DEFAULT_DOWNLINK_DELAY_US;
+    configuration->fragment_size_max = 0;
+    configuration->fragment_gap_us = 0;
+    configuration->noise_probability_permille = 0;
+    configuration->error_probability_permille = 0;
+    configuration->random_seed = 1;
+    configuration->tx_power_max_dbm = TD1208_TX_POWER_DBM_MAX;
+    configuration->warm_start_enable = 0;
+    configuration->replay_log = NULL;
+    configuration->replay_log_size_bytes = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_SIM_setup(TD1208_SIM_t* sim, TD1208_SIM_configuration_t* configuration) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_SIM_statistics_t empty_statistics = { 0 };
+    // Check parameters.
+    if ((sim == NULL) || (configuration == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    sim->configuration = (*configuration);
+    sim->initialized = 0;
+    sim->booted = 0;
+    sim->boot_end_time_us = 0;
+    sim->host_baud_rate = configuration->modem_baud_rate;
+    sim->modem_baud_rate = configuration->modem_baud_rate;
+    sim->time_us = 0;
+    sim->random_state = (configuration->random_seed == 0) ? 1 : configuration->random_seed;
+    sim->event = 0;
+    sim->command_size = 0;
+    sim->command_overflow = 0;
+    sim->output_head_idx = 0;
+    sim->output_count = 0;
+    sim->output_end_time_us = 0;
+    sim->fragment_remaining = 0;
+    sim->replay_idx = 0;
+    sim->tx_power_dbm = TD1208_TX_POWER_DBM_MAX;
+    sim->statistics = empty_statistics;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_SIM_advance(TD1208_SIM_t* sim, uint32_t duration_us) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameter.
+    if (sim == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    _TD1208_SIM_deliver(sim, (sim->time_us + duration_us));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_SIM_get_time(TD1208_SIM_t* sim, uint64_t* time_us) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameters.
+    if ((sim == NULL) || (time_us == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*time_us) = sim->time_us;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_SIM_get_statistics(TD1208_SIM_t* sim, TD1208_SIM_statistics_t* statistics) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameters.
+    if ((sim == NULL) || (statistics == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*statistics) = sim->statistics;
+errors:
+    return status;
+}
+
+#endif /* TD1208_DRIVER_DISABLE */
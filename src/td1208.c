@@ -21,328 +21,2462 @@
 
 /*** TD1208 local macros ***/
 
+#ifdef TD1208_DRIVER_UART_BAUD_RATE
+#define TD1208_UART_BAUD_RATE               TD1208_DRIVER_UART_BAUD_RATE
+#else
 #define TD1208_UART_BAUD_RATE               9600
+#endif
+#define TD1208_UART_BAUD_RATE_MIN           1200
+#define TD1208_UART_BAUD_RATE_MAX           115200
+#define TD1208_UART_BAUD_RATE_SIZE_CHAR     6
+
+#define TD1208_TX_POWER_SIZE_CHAR           2
+#define TD1208_SEND_BIT_ARGUMENT_SIZE_CHAR  3
 
 #define TD1208_BOOT_DELAY_MS                1000
+#ifdef TD1208_DRIVER_BOOT_PROBING
+#define TD1208_BOOT_PROBE_PERIOD_MS         50
+#endif
+
+#define TD1208_RX_BUFFER_INDEX_MASK         (TD1208_RX_BUFFER_SIZE_BYTES - 1)
 
-#define TD1208_BUFFER_SIZE_BYTES            64
+#define TD1208_LINE_FLAG_HEXADECIMAL        0x01
+#define TD1208_LINE_FLAG_OK                 0x02
+#define TD1208_LINE_FLAG_ERROR              0x04
+#define TD1208_LINE_FLAG_OVERRUN            0x08
+#define TD1208_LINE_FLAGS_RESET             (TD1208_LINE_FLAG_HEXADECIMAL | TD1208_LINE_FLAG_OK | TD1208_LINE_FLAG_ERROR)
+
+#define TD1208_REPLY_POLLING_PERIOD_MS      10
+
+#define TD1208_TIMEOUT_COMMAND_MS           1000
+#define TD1208_TIMEOUT_RESET_MS             2000
+#define TD1208_TIMEOUT_UPLINK_MS            10000
+#define TD1208_TIMEOUT_DOWNLINK_MS          60000
+#define TD1208_DOWNLINK_END_GRACE_MS        2000
+
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+#define TD1208_TIMEOUT_LEARNING_SAMPLES_MIN 8
+#define TD1208_TIMEOUT_LEARNING_MARGIN_MS   200
+#endif
 
-#define TD1208_REPLY_BUFFER_DEPTH           8
-#define TD1208_REPLY_PARSING_DELAY_MS       500
-#define TD1208_REPLY_PARSING_TIMEOUT_MS     10000
+#define TD1208_MODULE_INFO_COMMANDS_COUNT   3
 
 #define TD1208_SIGFOX_EP_ID_SIZE_CHAR       (TD1208_SIGFOX_EP_ID_SIZE_BYTES * MATH_U8_SIZE_HEXADECIMAL_DIGITS)
 
+#define TD1208_COMMAND_SEGMENT(literal)     { (uint8_t*) (literal), (uint32_t) (sizeof(literal) - 1) }
+#define TD1208_COMMAND_SEGMENT_NONE         { NULL, 0 }
+#define TD1208_COMMAND_SEGMENTS_MAX         3
+
+// Reply matching fields are filled from the command descriptor.
+#define TD1208_PENDING_COMMAND(data, data_size, status, callback) { TD1208_LINE_KIND_OK, 0, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_NONE, (uint8_t*) (data), (data_size), (status), (callback), 0 }
+
+#define TD1208_REPLY_OK                     "OK"
+#define TD1208_REPLY_ERROR                  "ERROR"
+#define TD1208_REPLY_HEADER_DOWNLINK        "RX="
+#define TD1208_REPLY_DOWNLINK_END           "RX END"
+#define TD1208_REPLY_SIZE(literal)          ((uint8_t) (sizeof(literal) - 1))
+
+#ifdef TD1208_DRIVER_STATISTICS
+#define TD1208_STATISTICS_LATENCY_MIN_RESET 0xFFFFFFFF
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+#define TD1208_UPLINK_BUDGET_WINDOW_MS      3600000
+#define TD1208_UPLINK_BUDGET_DEFAULT        6
+#define TD1208_UPLINK_PERIOD_DISABLED       0xFFFFFFFF
+#define TD1208_UPLINK_RETRIES_MAX           2
+#endif
+
 /*** TD1208 local structures ***/
 
 /*******************************************************************/
-typedef struct {
-    volatile char_t buffer[TD1208_BUFFER_SIZE_BYTES];
-    volatile uint8_t char_idx;
-    PARSER_context_t parser;
-} TD1208_reply_buffer_t;
+typedef enum {
+    TD1208_COMMAND_ID_AT = 0,
+    TD1208_COMMAND_ID_ATZ,
+    TD1208_COMMAND_ID_ATI7,
+    TD1208_COMMAND_ID_ATI11,
+    TD1208_COMMAND_ID_ATI13,
+    TD1208_COMMAND_ID_SEND_BIT,
+    TD1208_COMMAND_ID_SEND_FRAME,
+    TD1208_COMMAND_ID_SEND_FRAME_DOWNLINK,
+    TD1208_COMMAND_ID_SET_BAUD_RATE,
+    TD1208_COMMAND_ID_SET_TX_POWER,
+    TD1208_COMMAND_ID_LAST
+} TD1208_command_id_t;
 
 /*******************************************************************/
 typedef struct {
-    // Reply buffers.
-    TD1208_reply_buffer_t reply[TD1208_REPLY_BUFFER_DEPTH];
-    uint8_t reply_idx;
-} TD1208_context_t;
+    TD1208_HW_uart_buffer_t header;
+    TD1208_HW_uart_buffer_t trailer;
+    TD1208_line_kind_t expected_kind;
+    TD1208_timeout_profile_t timeout_profile;
+    TD1208_reply_data_t reply_data;
+} TD1208_command_descriptor_t;
 
 /*** TD1208 local global variables ***/
 
-static TD1208_context_t td1208_ctx;
+// Commands are sent as header, optional argument and trailer (lengths are computed at compile time).
+static const TD1208_command_descriptor_t TD1208_COMMAND_DESCRIPTOR[TD1208_COMMAND_ID_LAST] = {
+    { TD1208_COMMAND_SEGMENT("AT\r"), TD1208_COMMAND_SEGMENT_NONE, TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_NONE },
+    { TD1208_COMMAND_SEGMENT("ATZ\r"), TD1208_COMMAND_SEGMENT_NONE, TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_RESET, TD1208_REPLY_DATA_NONE },
+    { TD1208_COMMAND_SEGMENT("ATI7\r"), TD1208_COMMAND_SEGMENT_NONE, TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_SIGFOX_EP_ID },
+    { TD1208_COMMAND_SEGMENT("ATI11\r"), TD1208_COMMAND_SEGMENT_NONE, TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_TEXT },
+    { TD1208_COMMAND_SEGMENT("ATI13\r"), TD1208_COMMAND_SEGMENT_NONE, TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_TEXT },
+    // Uplink arguments end with the repeats count.
+    { TD1208_COMMAND_SEGMENT("AT$SB="), TD1208_COMMAND_SEGMENT("\r"), TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_UPLINK, TD1208_REPLY_DATA_NONE },
+    { TD1208_COMMAND_SEGMENT("AT$SF="), TD1208_COMMAND_SEGMENT("\r"), TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_UPLINK, TD1208_REPLY_DATA_NONE },
+    // Downlink command ends with the closing line of the RX exchange (no terminal line kind).
+    { TD1208_COMMAND_SEGMENT("AT$SF="), TD1208_COMMAND_SEGMENT(",1\r"), TD1208_LINE_KIND_LAST, TD1208_TIMEOUT_PROFILE_DOWNLINK, TD1208_REPLY_DATA_DOWNLINK },
+    { TD1208_COMMAND_SEGMENT("AT+IPR="), TD1208_COMMAND_SEGMENT("\r"), TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_NONE },
+    { TD1208_COMMAND_SEGMENT("ATS302="), TD1208_COMMAND_SEGMENT("\r"), TD1208_LINE_KIND_OK, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_NONE }
+};
+
+static const uint32_t TD1208_TIMEOUT_MS[TD1208_TIMEOUT_PROFILE_LAST] = {
+    TD1208_TIMEOUT_COMMAND_MS,
+    TD1208_TIMEOUT_RESET_MS,
+    TD1208_TIMEOUT_UPLINK_MS,
+    TD1208_TIMEOUT_DOWNLINK_MS
+};
+
+static const TD1208_tx_options_t TD1208_TX_OPTIONS_DEFAULT = { TD1208_TX_REPEATS_MAX, 0, 0 };
+
+static TD1208_handle_t td1208_default_handle;
+#ifdef TD1208_DRIVER_STATISTICS
+static const TD1208_statistics_t td1208_statistics_reset = { 0 };
+#endif
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+static const TD1208_uplink_queue_status_t td1208_uplink_queue_status_reset = { 0 };
+#endif
 
 /*** TD1208 local functions ***/
 
 /*******************************************************************/
-static void _TD1208_rx_irq_callback(uint8_t rx_byte) {
-    // Read current index.
-    uint8_t char_idx = td1208_ctx.reply[td1208_ctx.reply_idx].char_idx;
-    // Store incoming byte.
-    td1208_ctx.reply[td1208_ctx.reply_idx].buffer[char_idx] = (char_t) rx_byte;
-    // Manage index.
-    char_idx = (uint8_t) ((char_idx + 1) % TD1208_BUFFER_SIZE_BYTES);
-    td1208_ctx.reply[td1208_ctx.reply_idx].char_idx = char_idx;
-    // Check ending characters.
-    if (rx_byte == STRING_CHAR_LF) {
-        // Switch buffer.
-        td1208_ctx.reply_idx = (uint8_t) ((td1208_ctx.reply_idx + 1) % TD1208_REPLY_BUFFER_DEPTH);
+static uint8_t _TD1208_is_hexadecimal(char_t character) {
+    // Check character range.
+    return (((character >= '0') && (character <= '9')) || ((character >= 'A') && (character <= 'F')) || ((character >= 'a') && (character <= 'f')));
+}
+
+/*******************************************************************/
+static void _TD1208_signal_event(TD1208_handle_t* handle) {
+    // Optional hardware function.
+    if (handle->hw_ops->signal_event != NULL) {
+        handle->hw_ops->signal_event(handle->hw_context);
+    }
+}
+
+#ifdef TD1208_DRIVER_THREAD_SAFE
+/*******************************************************************/
+static void _TD1208_lock(TD1208_handle_t* handle) {
+    // Optional hardware function.
+    if (handle->hw_ops->mutex_lock != NULL) {
+        handle->hw_ops->mutex_lock(handle->hw_context);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_unlock(TD1208_handle_t* handle) {
+    // Optional hardware function (the lock is not taken when the handle is rejected).
+    if ((handle != NULL) && (handle->hw_ops->mutex_unlock != NULL)) {
+        handle->hw_ops->mutex_unlock(handle->hw_context);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_begin_transaction(TD1208_handle_t* handle) {
+    // Optional hardware function, the state mutex is always taken after the transaction one.
+    if (handle->hw_ops->transaction_lock != NULL) {
+        handle->hw_ops->transaction_lock(handle->hw_context);
+    }
+    _TD1208_lock(handle);
+}
+
+/*******************************************************************/
+static void _TD1208_end_transaction(TD1208_handle_t* handle) {
+    // Optional hardware function (the locks are not taken when the handle is rejected).
+    _TD1208_unlock(handle);
+    if ((handle != NULL) && (handle->hw_ops->transaction_unlock != NULL)) {
+        handle->hw_ops->transaction_unlock(handle->hw_context);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_release_state(TD1208_handle_t* handle) {
+    // The state mutex can only be released while waiting if transactions are serialized by their own mutex.
+    if (handle->hw_ops->transaction_lock != NULL) {
+        _TD1208_unlock(handle);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_acquire_state(TD1208_handle_t* handle) {
+    // Take back the state mutex released before waiting.
+    if (handle->hw_ops->transaction_lock != NULL) {
+        _TD1208_lock(handle);
+    }
+}
+#endif
+
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+/*******************************************************************/
+static void _TD1208_enter_critical(TD1208_handle_t* handle) {
+    // Optional hardware function.
+    if (handle->hw_ops->enter_critical != NULL) {
+        handle->hw_ops->enter_critical(handle->hw_context);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_exit_critical(TD1208_handle_t* handle) {
+    // Optional hardware function.
+    if (handle->hw_ops->exit_critical != NULL) {
+        handle->hw_ops->exit_critical(handle->hw_context);
+    }
+}
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+static uint32_t _TD1208_get_capture_time(TD1208_handle_t* handle) {
+    // Local variables.
+    uint32_t time_ms = 0;
+    // Optional hardware function, use the process function time otherwise.
+    if ((handle->hw_ops->get_time_ms == NULL) || (handle->hw_ops->get_time_ms(handle->hw_context, &time_ms) != TD1208_SUCCESS)) {
+        time_ms = handle->capture_clock_ms;
     }
+    return time_ms;
 }
 
 /*******************************************************************/
-static void _TD1208_reset_replies(void) {
+static uint16_t _TD1208_get_capture_record_size(TD1208_handle_t* handle, uint16_t record_idx) {
     // Local variables.
-    uint8_t rep_idx = 0;
-    uint8_t char_idx = 0;
-    // Reset replies buffers.
-    for (rep_idx = 0; rep_idx < TD1208_REPLY_BUFFER_DEPTH; rep_idx++) {
-        for (char_idx = 0; char_idx < TD1208_BUFFER_SIZE_BYTES; char_idx++) {
-            td1208_ctx.reply[rep_idx].buffer[char_idx] = STRING_CHAR_NULL;
+    uint16_t idx = (uint16_t) (record_idx + 1);
+    // Skip time field.
+    while ((handle->capture_buffer[idx % TD1208_CAPTURE_BUFFER_SIZE_BYTES] & 0x80) != 0) {
+        idx++;
+    }
+    idx++;
+    return (uint16_t) ((idx - record_idx) + (handle->capture_buffer[record_idx % TD1208_CAPTURE_BUFFER_SIZE_BYTES] & TD1208_CAPTURE_RECORD_SIZE_MASK));
+}
+
+/*******************************************************************/
+static void _TD1208_capture_record(TD1208_handle_t* handle, uint8_t direction, TD1208_HW_uart_buffer_t* chunks, uint8_t chunks_count) {
+    // Local variables.
+    uint8_t time[TD1208_CAPTURE_RECORD_TIME_SIZE_BYTES_MAX];
+    uint8_t time_size = 0;
+    uint32_t time_ms = _TD1208_get_capture_time(handle);
+    uint32_t delta_ms = (time_ms - handle->capture_time_ms);
+    uint8_t data_size = 0;
+    uint16_t record_size = 0;
+    uint32_t byte_idx = 0;
+    uint8_t idx = 0;
+    // Data size (truncated to the maximum record size).
+    for (idx = 0; idx < chunks_count; idx++) {
+        data_size = ((chunks[idx].size_bytes + data_size) > TD1208_CAPTURE_RECORD_SIZE_MASK) ? TD1208_CAPTURE_RECORD_SIZE_MASK : (uint8_t) (data_size + chunks[idx].size_bytes);
+    }
+    // Encode time since previous record.
+    do {
+        time[time_size] = (uint8_t) (delta_ms & 0x7F);
+        delta_ms >>= 7;
+        if (delta_ms != 0) {
+            time[time_size] |= 0x80;
+        }
+        time_size++;
+    }
+    while (delta_ms != 0);
+    record_size = (uint16_t) (1 + time_size + data_size);
+    // Overwrite oldest records if needed.
+    while ((uint16_t) (TD1208_CAPTURE_BUFFER_SIZE_BYTES - (uint16_t) (handle->capture_write_idx - handle->capture_read_idx)) < record_size) {
+        handle->capture_read_idx = (uint16_t) (handle->capture_read_idx + _TD1208_get_capture_record_size(handle, handle->capture_read_idx));
+        handle->capture_dropped_records_count++;
+    }
+    // Write record.
+    handle->capture_buffer[(handle->capture_write_idx++) % TD1208_CAPTURE_BUFFER_SIZE_BYTES] = (uint8_t) (direction | data_size);
+    for (idx = 0; idx < time_size; idx++) {
+        handle->capture_buffer[(handle->capture_write_idx++) % TD1208_CAPTURE_BUFFER_SIZE_BYTES] = time[idx];
+    }
+    for (idx = 0; (idx < chunks_count) && (data_size > 0); idx++) {
+        for (byte_idx = 0; (byte_idx < chunks[idx].size_bytes) && (data_size > 0); byte_idx++) {
+            handle->capture_buffer[(handle->capture_write_idx++) % TD1208_CAPTURE_BUFFER_SIZE_BYTES] = chunks[idx].data[byte_idx];
+            data_size--;
         }
-        td1208_ctx.reply[rep_idx].char_idx = 0;
-        // Reset parser.
-        td1208_ctx.reply[rep_idx].parser.buffer = (char_t*) td1208_ctx.reply[rep_idx].buffer;
-        td1208_ctx.reply[rep_idx].parser.buffer_size = 0;
-        td1208_ctx.reply[rep_idx].parser.separator_index = 0;
-        td1208_ctx.reply[rep_idx].parser.start_index = 0;
     }
-    // Reset index and count.
-    td1208_ctx.reply_idx = 0;
+    handle->capture_time_ms = time_ms;
 }
 
 /*******************************************************************/
-static TD1208_status_t _TD1208_send_command(char_t* command) {
+static void _TD1208_capture_rx_byte(TD1208_handle_t* handle, uint8_t rx_byte) {
     // Local variables.
-    TD1208_status_t status = TD1208_SUCCESS;
-    uint8_t command_buffer[TD1208_BUFFER_SIZE_BYTES] = { 0x00 };
-    uint8_t command_size = 0;
-    // Fill command buffer.
-    while (*command) {
-        command_buffer[command_size] = (uint8_t) (*(command++));
-        command_size++;
+    TD1208_HW_uart_buffer_t chunk = { handle->capture_rx_chunk, 0 };
+    // Append byte to current line.
+    handle->capture_rx_chunk[handle->capture_rx_chunk_size++] = rx_byte;
+    // Record line when it is complete or when the chunk is full.
+    if ((rx_byte == STRING_CHAR_LF) || (handle->capture_rx_chunk_size >= TD1208_CAPTURE_RECORD_SIZE_MASK)) {
+        chunk.size_bytes = handle->capture_rx_chunk_size;
+        _TD1208_capture_record(handle, TD1208_CAPTURE_RECORD_DIRECTION_RX, &chunk, 1);
+        handle->capture_rx_chunk_size = 0;
     }
-    command_buffer[command_size++] = STRING_CHAR_CR;
-    command_buffer[command_size++] = STRING_CHAR_NULL;
-    // Send command through UART.
-    status = TD1208_HW_uart_write(command_buffer, command_size);
-    if (status != TD1208_SUCCESS) goto errors;
-errors:
-    return status;
+}
+#endif
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_set_hw_baud_rate(TD1208_handle_t* handle, uint32_t baud_rate) {
+    // Optional hardware function.
+    return ((handle->hw_ops->set_baud_rate != NULL) ? handle->hw_ops->set_baud_rate(handle->hw_context, baud_rate) : TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED);
 }
 
 /*******************************************************************/
-static TD1208_status_t _TD1208_wait_for_string(char_t* ref) {
+static uint8_t _TD1208_rx_byte(TD1208_handle_t* handle, uint8_t rx_byte) {
     // Local variables.
-    TD1208_status_t status = TD1208_SUCCESS;
-    PARSER_status_t parser_status = PARSER_SUCCESS;
-    uint32_t parsing_time = 0;
-    uint8_t reply_idx = 0;
-    uint8_t reply_received = 0;
-    while (1) {
-        // Delay.
-        status = TD1208_HW_delay_milliseconds(TD1208_REPLY_PARSING_DELAY_MS);
-        if (status != TD1208_SUCCESS) goto errors;
-        // Update parsing time.
-        parsing_time += TD1208_REPLY_PARSING_DELAY_MS;
-        // Loop on all replies.
-        for (reply_idx = 0; reply_idx < TD1208_REPLY_BUFFER_DEPTH; reply_idx++) {
-            // Check size.
-            if (td1208_ctx.reply[reply_idx].char_idx != 0) {
-                // Update local flag.
-                reply_received = 1;
-                // Parse reply.
-                td1208_ctx.reply[reply_idx].parser.buffer_size = td1208_ctx.reply[reply_idx].char_idx;
-                parser_status = PARSER_compare(&td1208_ctx.reply[reply_idx].parser, PARSER_MODE_HEADER, ref);
-                // Update status.
-                if (parser_status == PARSER_SUCCESS) {
-                    status = TD1208_SUCCESS;
-                    goto errors;
-                }
-                else {
-                    status = (TD1208_ERROR_BASE_PARSER + parser_status);
-                }
+    uint8_t line_size = (uint8_t) (handle->rx_write_idx - handle->line_start_idx);
+    uint8_t line_idx = 0;
+    uint8_t line_published = 0;
+#ifdef TD1208_DRIVER_STATISTICS
+    handle->statistics_rx_bytes_count++;
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    _TD1208_capture_rx_byte(handle, rx_byte);
+#endif
+    // Check ending character, empty lines are ignored.
+    if ((rx_byte == STRING_CHAR_LF) && ((line_size != 0) || ((handle->line_flags & TD1208_LINE_FLAG_OVERRUN) != 0))) {
+        // Drop line if data has been lost or if lines index is full.
+        if (((handle->line_flags & TD1208_LINE_FLAG_OVERRUN) != 0) || ((uint8_t) (handle->line_write_count - handle->line_read_count) >= TD1208_LINE_INDEX_DEPTH)) {
+            handle->rx_write_idx = handle->line_start_idx;
+            handle->rx_overrun_count++;
+#ifdef TD1208_DRIVER_STATISTICS
+            handle->statistics_rx_overrun_count++;
+#endif
+        }
+        else {
+            // Classify line.
+            line_idx = (uint8_t) (handle->line_write_count % TD1208_LINE_INDEX_DEPTH);
+            handle->line[line_idx].offset = handle->line_start_idx;
+            handle->line[line_idx].size = line_size;
+            if (((handle->line_flags & TD1208_LINE_FLAG_OK) != 0) && (line_size == TD1208_REPLY_SIZE(TD1208_REPLY_OK))) {
+                handle->line[line_idx].kind = TD1208_LINE_KIND_OK;
+            }
+            else if (((handle->line_flags & TD1208_LINE_FLAG_ERROR) != 0) && (line_size == TD1208_REPLY_SIZE(TD1208_REPLY_ERROR))) {
+                handle->line[line_idx].kind = TD1208_LINE_KIND_ERROR;
+            }
+            else if ((handle->line_flags & TD1208_LINE_FLAG_HEXADECIMAL) != 0) {
+                handle->line[line_idx].kind = TD1208_LINE_KIND_HEXADECIMAL;
             }
+            else {
+                handle->line[line_idx].kind = TD1208_LINE_KIND_UNSOLICITED;
+            }
+            // Publish line.
+            handle->line_write_count++;
+            line_published = 1;
+        }
+        // Start next line.
+        handle->line_start_idx = handle->rx_write_idx;
+        handle->line_flags = TD1208_LINE_FLAGS_RESET;
+    }
+    else if ((rx_byte != STRING_CHAR_LF) && (rx_byte != STRING_CHAR_CR)) {
+        // Check free space.
+        if ((uint8_t) (handle->rx_write_idx - handle->rx_read_idx) >= TD1208_RX_BUFFER_SIZE_BYTES) {
+            handle->line_flags |= TD1208_LINE_FLAG_OVERRUN;
         }
-        // Manage timeout.
-        if (parsing_time > TD1208_REPLY_PARSING_TIMEOUT_MS) {
-            // Update error code.
-            if (reply_received == 0) {
-                status = TD1208_ERROR_REPLY_TIMEOUT;
+        else {
+            // Store incoming byte.
+            handle->rx_buffer[handle->rx_write_idx & TD1208_RX_BUFFER_INDEX_MASK] = (char_t) rx_byte;
+            handle->rx_write_idx++;
+#ifdef TD1208_DRIVER_STATISTICS
+            if ((handle->rx_write_idx & TD1208_RX_BUFFER_INDEX_MASK) == 0) {
+                handle->statistics_rx_buffer_wrap_count++;
+            }
+#endif
+            // Update line flags.
+            if (_TD1208_is_hexadecimal((char_t) rx_byte) == 0) {
+                handle->line_flags &= (uint8_t) (~TD1208_LINE_FLAG_HEXADECIMAL);
+            }
+            if ((line_size >= TD1208_REPLY_SIZE(TD1208_REPLY_OK)) || (rx_byte != (uint8_t) (TD1208_REPLY_OK[line_size]))) {
+                handle->line_flags &= (uint8_t) (~TD1208_LINE_FLAG_OK);
+            }
+            if ((line_size >= TD1208_REPLY_SIZE(TD1208_REPLY_ERROR)) || (rx_byte != (uint8_t) (TD1208_REPLY_ERROR[line_size]))) {
+                handle->line_flags &= (uint8_t) (~TD1208_LINE_FLAG_ERROR);
             }
-            goto errors;
         }
     }
-errors:
-    return status;
+    return line_published;
 }
 
-/*** TD1208 functions ***/
+/*******************************************************************/
+static void _TD1208_instance_rx_irq_callback(TD1208_handle_t* handle, uint8_t rx_byte) {
+    // Parse byte.
+    if (_TD1208_rx_byte(handle, rx_byte) != 0) {
+        _TD1208_signal_event(handle);
+    }
+}
 
 /*******************************************************************/
-TD1208_status_t TD1208_init(void) {
+static void _TD1208_rx_irq_callback(uint8_t rx_byte) {
+    // Forward to default instance.
+    _TD1208_instance_rx_irq_callback(&td1208_default_handle, rx_byte);
+}
+
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+/*******************************************************************/
+static void _TD1208_instance_rx_block_callback(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes) {
+    // Local variables.
+    uint8_t line_published = 0;
+    uint32_t idx = 0;
+    // Parse all bytes.
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        line_published |= _TD1208_rx_byte(handle, data[idx]);
+    }
+    // Signal event once for the whole block.
+    if (line_published != 0) {
+        _TD1208_signal_event(handle);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_rx_block_callback(uint8_t* data, uint32_t data_size_bytes) {
+    // Forward to default instance.
+    _TD1208_instance_rx_block_callback(&td1208_default_handle, data, data_size_bytes);
+}
+#endif
+
+/*******************************************************************/
+static void _TD1208_release_line(TD1208_handle_t* handle, volatile TD1208_line_t* line) {
+    // Free line bytes and index entry.
+    handle->rx_read_idx = (uint8_t) (line->offset + line->size);
+    handle->line_read_count++;
+}
+
+/*******************************************************************/
+static void _TD1208_flush_lines(TD1208_handle_t* handle) {
+    // Local variables.
+    uint8_t line_write_count = 0;
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Lines index and overrun counter must not move while they are flushed.
+    _TD1208_enter_critical(handle);
+#endif
+    line_write_count = handle->line_write_count;
+    // Discard all published lines, the line being received is kept.
+    if (line_write_count != handle->line_read_count) {
+#ifdef TD1208_DRIVER_STATISTICS
+        handle->statistics.unmatched_lines_count += (uint8_t) (line_write_count - handle->line_read_count);
+#endif
+        handle->line_read_count = (uint8_t) (line_write_count - 1);
+        _TD1208_release_line(handle, &(handle->line[handle->line_read_count % TD1208_LINE_INDEX_DEPTH]));
+    }
+    handle->rx_overrun_read_count = handle->rx_overrun_count;
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_exit_critical(handle);
+#endif
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_send_command(TD1208_handle_t* handle, TD1208_HW_uart_buffer_t* command, uint8_t command_segments_count) {
     // Local variables.
     TD1208_status_t status = TD1208_SUCCESS;
-    TD1208_HW_configuration_t hw_config;
-    // Init buffers.
-    _TD1208_reset_replies();
-    // Init hardware interface.
-    hw_config.uart_baud_rate = TD1208_UART_BAUD_RATE;
-    hw_config.rx_irq_callback = &_TD1208_rx_irq_callback;
-    status = TD1208_HW_init(&hw_config);
-    if (status != TD1208_SUCCESS) goto errors;
-    // Boot delay.
-    status = TD1208_HW_delay_milliseconds(TD1208_BOOT_DELAY_MS);
+    uint8_t idx = 0;
+#ifdef TD1208_DRIVER_CAPTURE
+    // Record command before sending it (RX records may be written as soon as the first byte is sent).
+    _TD1208_enter_critical(handle);
+    _TD1208_capture_record(handle, TD1208_CAPTURE_RECORD_DIRECTION_TX, command, command_segments_count);
+    _TD1208_exit_critical(handle);
+#endif
+    // Send all segments at once.
+    status = (handle->hw_ops->uart_write_vector != NULL) ? handle->hw_ops->uart_write_vector(handle->hw_context, command, command_segments_count) : TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    // Send segments one by one if vector write is not implemented.
+    if (status == TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED) {
+        status = TD1208_SUCCESS;
+        for (idx = 0; idx < command_segments_count; idx++) {
+            // Skip empty segments.
+            if (command[idx].size_bytes == 0) continue;
+            // Send segment through UART.
+            status = handle->hw_ops->uart_write(handle->hw_context, command[idx].data, command[idx].size_bytes);
+            if (status != TD1208_SUCCESS) goto errors;
+        }
+    }
     if (status != TD1208_SUCCESS) goto errors;
+#ifdef TD1208_DRIVER_STATISTICS
+    for (idx = 0; idx < command_segments_count; idx++) {
+        handle->statistics.tx_bytes_count += command[idx].size_bytes;
+    }
+#endif
 errors:
     return status;
 }
 
 /*******************************************************************/
-TD1208_status_t TD1208_de_init(void) {
+static TD1208_status_t _TD1208_sleep_until_event(TD1208_handle_t* handle, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Optional hardware function.
+    return ((handle->hw_ops->sleep_until_event != NULL) ? handle->hw_ops->sleep_until_event(handle->hw_context, timeout_ms, elapsed_ms) : TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_wait_event(TD1208_handle_t* handle, uint32_t timeout_ms, uint32_t* elapsed_ms) {
     // Local variables.
     TD1208_status_t status = TD1208_SUCCESS;
-    status = TD1208_HW_de_init();
-    if (status != TD1208_SUCCESS) goto errors;
-errors:
+    TD1208_status_t sleep_status = TD1208_SUCCESS;
+    uint32_t delay_ms = 0;
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Other tasks can access the handle state while the transaction is waiting.
+    _TD1208_release_state(handle);
+#endif
+    // Enter low power mode until RX event.
+    sleep_status = _TD1208_sleep_until_event(handle, timeout_ms, elapsed_ms);
+    status = sleep_status;
+    // Wait for RX event if low power mode is not implemented.
+    if (status == TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED) {
+        status = (handle->hw_ops->wait_event != NULL) ? handle->hw_ops->wait_event(handle->hw_context, timeout_ms, elapsed_ms) : TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    }
+    // Use polling if event is not implemented.
+    if (status == TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED) {
+        delay_ms = (timeout_ms < TD1208_REPLY_POLLING_PERIOD_MS) ? timeout_ms : TD1208_REPLY_POLLING_PERIOD_MS;
+        status = handle->hw_ops->delay_milliseconds(handle->hw_context, delay_ms);
+        (*elapsed_ms) = delay_ms;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_acquire_state(handle);
+#endif
+#ifdef TD1208_DRIVER_STATISTICS
+    if (status == TD1208_SUCCESS) {
+        handle->statistics.blocked_time_ms += (*elapsed_ms);
+        if (sleep_status == TD1208_SUCCESS) {
+            handle->statistics.sleep_time_ms += (*elapsed_ms);
+        }
+    }
+#endif
     return status;
 }
 
 /*******************************************************************/
-TD1208_status_t TD1208_reset(void) {
+static TD1208_status_t _TD1208_delay(TD1208_handle_t* handle, uint32_t delay_ms) {
     // Local variables.
     TD1208_status_t status = TD1208_SUCCESS;
-    // Reset parser.
-    _TD1208_reset_replies();
-    // Send command.
-    status = _TD1208_send_command("ATZ");
-    if (status != TD1208_SUCCESS) goto errors;
-    // Wait for command completion.
-    status = _TD1208_wait_for_string("OK");
-errors:
+    uint32_t remaining_ms = delay_ms;
+    uint32_t elapsed_ms = 0;
+    // Sleep until the delay is elapsed (RX events only wake up the core).
+    while (remaining_ms > 0) {
+        status = _TD1208_sleep_until_event(handle, remaining_ms, &elapsed_ms);
+        if (status != TD1208_SUCCESS) break;
+#ifdef TD1208_DRIVER_STATISTICS
+        handle->statistics.sleep_time_ms += elapsed_ms;
+#endif
+        remaining_ms = (elapsed_ms < remaining_ms) ? (remaining_ms - elapsed_ms) : 0;
+    }
+    // Use blocking delay if low power mode is not implemented.
+    if (status == TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED) {
+        status = handle->hw_ops->delay_milliseconds(handle->hw_context, remaining_ms);
+    }
+#ifdef TD1208_DRIVER_STATISTICS
+    if (status == TD1208_SUCCESS) {
+        handle->statistics.blocked_time_ms += delay_ms;
+    }
+#endif
     return status;
 }
 
 /*******************************************************************/
-TD1208_status_t TD1208_get_sigfox_ep_id(uint8_t* sigfox_ep_id) {
+static uint32_t _TD1208_get_timeout(TD1208_handle_t* handle, TD1208_timeout_profile_t timeout_profile) {
+    // Local variables.
+    uint32_t timeout_ms = handle->timeout_ms[timeout_profile];
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+    uint32_t learned_timeout_ms = 0;
+    // Tighten timeout once enough replies have been observed.
+    if (handle->timeout_learned_samples[timeout_profile] >= TD1208_TIMEOUT_LEARNING_SAMPLES_MIN) {
+        learned_timeout_ms = (handle->timeout_learned_latency_ms[timeout_profile] << 1) + TD1208_TIMEOUT_LEARNING_MARGIN_MS;
+        if (learned_timeout_ms < timeout_ms) {
+            timeout_ms = learned_timeout_ms;
+        }
+    }
+#endif
+    return timeout_ms;
+}
+
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+/*******************************************************************/
+static void _TD1208_learn_timeout(TD1208_handle_t* handle, TD1208_timeout_profile_t timeout_profile, TD1208_status_t command_status) {
+    // Local variables.
+    uint32_t* latency_ms = &(handle->timeout_learned_latency_ms[timeout_profile]);
+    uint8_t* samples = &(handle->timeout_learned_samples[timeout_profile]);
+    // Restart learning with the configured timeout when a reply is missed.
+    if ((command_status == TD1208_ERROR_REPLY_TIMEOUT) || (command_status == TD1208_ERROR_UNEXPECTED_REPLY)) {
+        (*samples) = 0;
+        goto errors;
+    }
+    if (command_status != TD1208_SUCCESS) goto errors;
+    // Track latency envelope: fast attack, slow decay.
+    if (((*samples) == 0) || (handle->elapsed_ms > (*latency_ms))) {
+        (*latency_ms) = handle->elapsed_ms;
+    }
+    else {
+        (*latency_ms) -= (((*latency_ms) - handle->elapsed_ms) >> 3);
+    }
+    if ((*samples) < 0xFF) {
+        (*samples)++;
+    }
+errors:
+    return;
+}
+#endif
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_start_command(TD1208_handle_t* handle, TD1208_HW_uart_buffer_t* command, uint8_t command_segments_count, TD1208_pending_command_t* pending_command) {
     // Local variables.
     TD1208_status_t status = TD1208_SUCCESS;
-    PARSER_status_t parser_status = PARSER_SUCCESS;
-    char_t temp_char = STRING_CHAR_NULL;
-    uint8_t rep_idx = 0;
-    uint8_t line_size = 0;
-    uint32_t extracted_size = 0;
-    int8_t idx = 0;
-    // Check parameter.
-    if (sigfox_ep_id == NULL) {
-        status = TD1208_ERROR_NULL_PARAMETER;
+    uint8_t command_idx = 0;
+    // Check queue.
+    if (handle->command_count >= TD1208_COMMAND_QUEUE_DEPTH) {
+        status = TD1208_ERROR_BUSY;
         goto errors;
     }
-    // Reset parser.
-    _TD1208_reset_replies();
+    // Discard previous replies when no command is pending.
+    if (handle->command_count == 0) {
+        _TD1208_flush_lines(handle);
+        handle->elapsed_ms = 0;
+        handle->reply_received = 0;
+        handle->reply_data_found = 0;
+        handle->uplink_acknowledged = 0;
+    }
     // Send command.
-    status = _TD1208_send_command("ATI7");
-    if (status != TD1208_SUCCESS) goto errors;
-    // Wait for command completion.
-    status = _TD1208_wait_for_string("OK");
+    status = _TD1208_send_command(handle, command, command_segments_count);
     if (status != TD1208_SUCCESS) goto errors;
-    // Search ID in all replies.
-    for (rep_idx = 0; rep_idx < TD1208_REPLY_BUFFER_DEPTH; rep_idx++) {
-        // Replace unwanted characters.
-        for (idx = 0; idx < TD1208_BUFFER_SIZE_BYTES; idx++) {
-            temp_char = td1208_ctx.reply[rep_idx].buffer[idx];
-            if ((temp_char == STRING_CHAR_CR) || (temp_char == STRING_CHAR_LF)) {
-                td1208_ctx.reply[rep_idx].buffer[idx] = STRING_CHAR_NULL;
-            }
-        }
-        // Count the number of characters.
-        line_size = 0;
-        for (idx = 0; idx < TD1208_BUFFER_SIZE_BYTES; idx++) {
-            if (td1208_ctx.reply[rep_idx].buffer[idx] == STRING_CHAR_NULL) {
-                break;
-            }
-            else {
-                line_size++;
-            }
-        }
-        // Check length.
-        if ((line_size > 0) && (line_size <= TD1208_SIGFOX_EP_ID_SIZE_CHAR)) {
-            // Shift buffer.
-            for (idx = (TD1208_SIGFOX_EP_ID_SIZE_CHAR - 1); idx >= (TD1208_SIGFOX_EP_ID_SIZE_CHAR - line_size); idx--) {
-                td1208_ctx.reply[rep_idx].buffer[idx] = td1208_ctx.reply[rep_idx].buffer[idx - line_size];
-            }
-            // Pad most significant symbols with zeroes.
-            for (; idx >= 0; idx--) {
-                td1208_ctx.reply[rep_idx].buffer[idx] = '0';
-            }
-            // Try parsing ID.
-            td1208_ctx.reply[rep_idx].parser.buffer_size = TD1208_SIGFOX_EP_ID_SIZE_CHAR;
-            parser_status = PARSER_get_byte_array(&td1208_ctx.reply[rep_idx].parser, STRING_CHAR_NULL, TD1208_SIGFOX_EP_ID_SIZE_BYTES, 1, sigfox_ep_id, &extracted_size);
-            // Update status.
-            if (parser_status == PARSER_SUCCESS) {
-                status = TD1208_SUCCESS;
-                goto errors;
-            }
-            else {
-                status = (TD1208_ERROR_BASE_PARSER + parser_status);
-            }
+    // Push command in queue.
+    command_idx = (uint8_t) ((handle->command_head_idx + handle->command_count) % TD1208_COMMAND_QUEUE_DEPTH);
+    handle->command[command_idx] = (*pending_command);
+    if (handle->command[command_idx].timeout_ms == 0) {
+        handle->command[command_idx].timeout_ms = _TD1208_get_timeout(handle, pending_command->timeout_profile);
+    }
+    else {
+        // Explicit timeout is not learned.
+        handle->command[command_idx].timeout_profile = TD1208_TIMEOUT_PROFILE_LAST;
+    }
+    handle->command_count++;
+#ifdef TD1208_DRIVER_STATISTICS
+    handle->statistics_command_start_ms[command_idx] = handle->statistics_time_ms;
+    handle->statistics.commands_sent_count++;
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_start_descriptor_command(TD1208_handle_t* handle, TD1208_command_id_t command_id, TD1208_HW_uart_buffer_t* argument, TD1208_pending_command_t* pending_command) {
+    // Local variables.
+    const TD1208_command_descriptor_t* descriptor = &(TD1208_COMMAND_DESCRIPTOR[command_id]);
+    TD1208_HW_uart_buffer_t command[TD1208_COMMAND_SEGMENTS_MAX];
+    uint8_t command_segments_count = 0;
+    // Build segments.
+    command[command_segments_count++] = descriptor->header;
+    if (argument != NULL) {
+        command[command_segments_count++] = (*argument);
+    }
+    if (descriptor->trailer.size_bytes != 0) {
+        command[command_segments_count++] = descriptor->trailer;
+    }
+    // Reply matching.
+    pending_command->expected_kind = descriptor->expected_kind;
+    pending_command->timeout_profile = descriptor->timeout_profile;
+    pending_command->reply_data = descriptor->reply_data;
+    // Send command.
+    return _TD1208_start_command(handle, command, command_segments_count, pending_command);
+}
+
+/*******************************************************************/
+static void _TD1208_parse_sigfox_ep_id(TD1208_handle_t* handle, volatile TD1208_line_t* line) {
+    // Local variables.
+    uint32_t sigfox_ep_id_value = 0;
+    char_t character = STRING_CHAR_NULL;
+    uint8_t idx = 0;
+    // Check line kind and length.
+    if ((line->kind != TD1208_LINE_KIND_HEXADECIMAL) || (line->size > TD1208_SIGFOX_EP_ID_SIZE_CHAR)) goto errors;
+    // Convert digits, most significant symbols are implicitly padded with zeroes.
+    for (idx = 0; idx < line->size; idx++) {
+        character = handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK];
+        sigfox_ep_id_value <<= 4;
+        if (character <= '9') {
+            sigfox_ep_id_value |= (uint32_t) (character - '0');
         }
         else {
-            status = (TD1208_ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+            sigfox_ep_id_value |= (uint32_t) ((character & 0xDF) - 'A' + 10);
         }
     }
+    for (idx = 0; idx < TD1208_SIGFOX_EP_ID_SIZE_BYTES; idx++) {
+        handle->module_info.sigfox_ep_id[idx] = (uint8_t) (sigfox_ep_id_value >> (8 * (TD1208_SIGFOX_EP_ID_SIZE_BYTES - 1 - idx)));
+    }
+    handle->reply_data_found = 1;
 errors:
-    return status;
+    return;
 }
 
 /*******************************************************************/
-TD1208_status_t TD1208_send_bit(uint8_t ul_bit) {
+static void _TD1208_parse_text(TD1208_handle_t* handle, volatile TD1208_line_t* line, char_t* text, uint8_t text_size) {
     // Local variables.
-    TD1208_status_t status = TD1208_SUCCESS;
-    char_t command[TD1208_BUFFER_SIZE_BYTES] = { 0x00 };
-    // Reset parser.
-    _TD1208_reset_replies();
-    // Build AT command.
-    command[0] = 'A';
-    command[1] = 'T';
-    command[2] = '$';
-    command[3] = 'S';
-    command[4] = 'B';
-    command[5] = '=';
-    command[6] = ul_bit ? '1' : '0';
-    command[7] = ',';
-    command[8] = '2';
-    command[9] = STRING_CHAR_NULL;
-    // Send command through UART.
-    status = _TD1208_send_command(command);
-    if (status != TD1208_SUCCESS) goto errors;
-    // Wait for reply.
-    status = _TD1208_wait_for_string("OK");
-    if (status != TD1208_SUCCESS) goto errors;
+    uint8_t idx = 0;
+    // Ignore status lines and command echo.
+    if ((line->kind == TD1208_LINE_KIND_OK) || (line->kind == TD1208_LINE_KIND_ERROR)) goto errors;
+    if ((line->size >= 2) && (handle->rx_buffer[line->offset & TD1208_RX_BUFFER_INDEX_MASK] == 'A') && (handle->rx_buffer[(line->offset + 1) & TD1208_RX_BUFFER_INDEX_MASK] == 'T')) goto errors;
+    // Copy line.
+    for (idx = 0; (idx < line->size) && (idx < (text_size - 1)); idx++) {
+        text[idx] = handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK];
+    }
+    text[idx] = STRING_CHAR_NULL;
+    handle->reply_data_found = 1;
 errors:
-    return status;
+    return;
 }
 
 /*******************************************************************/
-TD1208_status_t TD1208_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes) {
+static void _TD1208_parse_downlink(TD1208_handle_t* handle, volatile TD1208_line_t* line, TD1208_downlink_t* downlink) {
     // Local variables.
-    TD1208_status_t status = TD1208_SUCCESS;
-    STRING_status_t string_status = STRING_SUCCESS;
-    char_t command[TD1208_BUFFER_SIZE_BYTES] = { 0x00 };
+    TD1208_downlink_t downlink_frame;
+    char_t character = STRING_CHAR_NULL;
+    uint8_t digit = 0;
+    uint8_t digits_count = 0;
+    uint8_t rssi_negative = 0;
+    uint8_t header_idx = 0;
     uint8_t idx = 0;
-    // Check parameters.
-    if (ul_payload == NULL) {
-        status = TD1208_ERROR_NULL_PARAMETER;
-        goto errors;
+    // Expected format: [+]RX=<8 bytes in hexadecimal, optionally separated by spaces>[,<RSSI>].
+    if ((line->size > 0) && (handle->rx_buffer[line->offset & TD1208_RX_BUFFER_INDEX_MASK] == '+')) {
+        idx++;
     }
-    if (ul_payload_size_bytes > TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX) {
-        status = TD1208_ERROR_SIGFOX_UL_PAYLOAD_SIZE;
-        goto errors;
+    if ((idx + TD1208_REPLY_SIZE(TD1208_REPLY_HEADER_DOWNLINK)) > line->size) goto errors;
+    for (header_idx = 0; header_idx < TD1208_REPLY_SIZE(TD1208_REPLY_HEADER_DOWNLINK); header_idx++) {
+        if (handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK] != TD1208_REPLY_HEADER_DOWNLINK[header_idx]) goto errors;
+        idx++;
     }
-    // Reset parser.
-    _TD1208_reset_replies();
-    // Header.
-    command[idx++] = 'A';
-    command[idx++] = 'T';
-    command[idx++] = '$';
-    command[idx++] = 'S';
-    command[idx++] = 'F';
-    command[idx++] = '=';
-    // Data.
-    string_status = STRING_byte_array_to_hexadecimal_string(ul_payload, ul_payload_size_bytes, 0, (char_t*) &(command[idx]));
-    STRING_exit_error(TD1208_ERROR_BASE_STRING);
-    // AT command end.
-    idx += (uint8_t) (ul_payload_size_bytes * MATH_U8_SIZE_HEXADECIMAL_DIGITS);
-    command[idx++] = STRING_CHAR_NULL;
-    // Send command through UART.
-    status = _TD1208_send_command(command);
-    if (status != TD1208_SUCCESS) goto errors;
-    // Wait for reply.
-    status = _TD1208_wait_for_string("OK");
-    if (status != TD1208_SUCCESS) goto errors;
-errors:
-    return status;
-}
+    // Payload.
+    for (; (idx < line->size) && (digits_count < (TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES * MATH_U8_SIZE_HEXADECIMAL_DIGITS)); idx++) {
+        character = handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK];
+        if (character == STRING_CHAR_SPACE) continue;
+        if (_TD1208_is_hexadecimal(character) == 0) goto errors;
+        digit = (uint8_t) ((character <= '9') ? (character - '0') : ((character & 0xDF) - 'A' + 10));
+        if ((digits_count % MATH_U8_SIZE_HEXADECIMAL_DIGITS) == 0) {
+            downlink_frame.dl_payload[digits_count >> 1] = (uint8_t) (digit << 4);
+        }
+        else {
+            downlink_frame.dl_payload[digits_count >> 1] |= digit;
+        }
+        digits_count++;
+    }
+    if (digits_count < (TD1208_SIGFOX_DL_PAYLOAD_SIZE_BYTES * MATH_U8_SIZE_HEXADECIMAL_DIGITS)) goto errors;
+    // Optional RSSI.
+    downlink_frame.rssi_dbm = 0;
+    downlink_frame.rssi_valid = 0;
+    if ((idx < line->size) && (handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK] == ',')) {
+        idx++;
+        if ((idx < line->size) && (handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK] == STRING_CHAR_MINUS)) {
+            rssi_negative = 1;
+            idx++;
+        }
+        for (; idx < line->size; idx++) {
+            character = handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK];
+            if ((character < '0') || (character > '9')) break;
+            downlink_frame.rssi_dbm = (int16_t) ((downlink_frame.rssi_dbm * 10) + (character - '0'));
+            downlink_frame.rssi_valid = 1;
+        }
+        if (rssi_negative != 0) {
+            downlink_frame.rssi_dbm = (int16_t) (-downlink_frame.rssi_dbm);
+        }
+    }
+    (*downlink) = downlink_frame;
+    handle->reply_data_found = 1;
+errors:
+    return;
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_is_downlink_end(TD1208_handle_t* handle, volatile TD1208_line_t* line) {
+    // Local variables.
+    uint8_t downlink_end = 0;
+    uint8_t reply_idx = 0;
+    uint8_t idx = 0;
+    // Expected format: [+]RX END.
+    if ((line->size > 0) && (handle->rx_buffer[line->offset & TD1208_RX_BUFFER_INDEX_MASK] == '+')) {
+        idx++;
+    }
+    if ((idx + TD1208_REPLY_SIZE(TD1208_REPLY_DOWNLINK_END)) != line->size) goto errors;
+    for (reply_idx = 0; reply_idx < TD1208_REPLY_SIZE(TD1208_REPLY_DOWNLINK_END); reply_idx++) {
+        if (handle->rx_buffer[(line->offset + idx) & TD1208_RX_BUFFER_INDEX_MASK] != TD1208_REPLY_DOWNLINK_END[reply_idx]) goto errors;
+        idx++;
+    }
+    downlink_end = 1;
+errors:
+    return downlink_end;
+}
+
+/*******************************************************************/
+static void _TD1208_copy_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Copy cached value.
+    for (idx = 0; idx < TD1208_SIGFOX_EP_ID_SIZE_BYTES; idx++) {
+        sigfox_ep_id[idx] = handle->module_info.sigfox_ep_id[idx];
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_end_command(TD1208_handle_t* handle, TD1208_status_t command_status) {
+    // Local variables.
+    TD1208_pending_command_t* pending_command = &(handle->command[handle->command_head_idx]);
+    TD1208_completion_cb_t completion_callback = pending_command->completion_callback;
+#ifdef TD1208_DRIVER_STATISTICS
+    uint32_t latency_ms = 0;
+#endif
+    // Check reply data if required.
+    if ((command_status == TD1208_SUCCESS) && (pending_command->reply_data != TD1208_REPLY_DATA_NONE) && (handle->reply_data_found == 0)) {
+        command_status = (TD1208_ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+    }
+    // Check the TX power command queued before the uplink (it has already completed since replies are matched in FIFO order).
+    if ((command_status == TD1208_SUCCESS) && (pending_command->tx_power_check != 0) && (handle->tx_power_status != TD1208_SUCCESS)) {
+        command_status = TD1208_ERROR_TX_POWER;
+    }
+    // Update Sigfox EP ID cache.
+    if ((command_status == TD1208_SUCCESS) && (pending_command->reply_data == TD1208_REPLY_DATA_SIGFOX_EP_ID)) {
+        handle->sigfox_ep_id_valid = 1;
+        if (pending_command->data != NULL) {
+            _TD1208_copy_sigfox_ep_id(handle, pending_command->data);
+        }
+    }
+#ifdef TD1208_DRIVER_STATISTICS
+    // Update outcomes and latency.
+    switch (command_status) {
+    case TD1208_SUCCESS:
+        handle->statistics.commands_success_count++;
+        break;
+    case TD1208_ERROR_REPLY_TIMEOUT:
+        handle->statistics.commands_timeout_count++;
+        break;
+    case TD1208_ERROR_UNEXPECTED_REPLY:
+        handle->statistics.commands_unexpected_reply_count++;
+        break;
+    case TD1208_ERROR_RX_OVERRUN:
+        handle->statistics.commands_rx_overrun_count++;
+        break;
+    case TD1208_ERROR_COMMAND_REJECTED:
+        handle->statistics.commands_rejected_count++;
+        break;
+    default:
+        handle->statistics.commands_other_error_count++;
+        break;
+    }
+    latency_ms = (handle->statistics_time_ms - handle->statistics_command_start_ms[handle->command_head_idx]);
+    if (latency_ms < handle->statistics.command_latency_min_ms) {
+        handle->statistics.command_latency_min_ms = latency_ms;
+    }
+    if (latency_ms > handle->statistics.command_latency_max_ms) {
+        handle->statistics.command_latency_max_ms = latency_ms;
+    }
+    handle->statistics_latency_total_ms += latency_ms;
+#endif
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+    if (pending_command->timeout_profile < TD1208_TIMEOUT_PROFILE_LAST) {
+        _TD1208_learn_timeout(handle, pending_command->timeout_profile, command_status);
+    }
+#endif
+    // Update status.
+    handle->last_command_status = command_status;
+    handle->last_command_duration_ms = handle->elapsed_ms;
+    if (pending_command->status != NULL) {
+        (*(pending_command->status)) = command_status;
+    }
+    // Pop command from queue.
+    handle->command_head_idx = (uint8_t) ((handle->command_head_idx + 1) % TD1208_COMMAND_QUEUE_DEPTH);
+    handle->command_count--;
+    handle->elapsed_ms = 0;
+    handle->reply_received = 0;
+    handle->reply_data_found = 0;
+    handle->uplink_acknowledged = 0;
+    // Notify caller.
+    if (completion_callback != NULL) {
+        completion_callback(handle, command_status);
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_abort_commands(TD1208_handle_t* handle, uint8_t started_count) {
+    // Local variables.
+    TD1208_pending_command_t* pending_command = NULL;
+    uint8_t idx = 0;
+    // Commands of the caller are the last ones of the queue, older commands are still pending if none of them has completed.
+    if (started_count > handle->command_count) {
+        started_count = handle->command_count;
+    }
+    // Commands have already been sent, so they are kept in queue to consume their replies but detached from the caller context.
+    for (idx = (uint8_t) (handle->command_count - started_count); idx < handle->command_count; idx++) {
+        pending_command = &(handle->command[(handle->command_head_idx + idx) % TD1208_COMMAND_QUEUE_DEPTH]);
+        if (pending_command->status != NULL) {
+            (*(pending_command->status)) = TD1208_ERROR_COMMAND_ABORTED;
+        }
+        pending_command->data = NULL;
+        pending_command->data_size = 0;
+        pending_command->status = NULL;
+        pending_command->completion_callback = NULL;
+    }
+}
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*******************************************************************/
+static void _TD1208_update_uplink_time(TD1208_handle_t* handle, uint32_t elapsed_ms) {
+    // Update time base and refill messages budget.
+    handle->uplink_time_ms += elapsed_ms;
+    handle->uplink_credit_ms += elapsed_ms;
+    if (handle->uplink_credit_ms > TD1208_UPLINK_BUDGET_WINDOW_MS) {
+        handle->uplink_credit_ms = TD1208_UPLINK_BUDGET_WINDOW_MS;
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _TD1208_process(TD1208_handle_t* handle, uint32_t elapsed_ms) {
+    // Local variables.
+    TD1208_pending_command_t* pending_command = NULL;
+    volatile TD1208_line_t* line = NULL;
+    TD1208_line_kind_t kind = TD1208_LINE_KIND_UNSOLICITED;
+    uint8_t reply_end = 0;
+    // Update time bases.
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+    _TD1208_update_uplink_time(handle, elapsed_ms);
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    handle->capture_clock_ms += elapsed_ms;
+#endif
+    // Check state.
+    if (handle->command_count == 0) goto errors;
+    // Update oldest command time.
+    handle->elapsed_ms += elapsed_ms;
+#ifdef TD1208_DRIVER_STATISTICS
+    handle->statistics_time_ms += elapsed_ms;
+#endif
+    // Check lost lines.
+    if (handle->rx_overrun_read_count != handle->rx_overrun_count) {
+        handle->rx_overrun_read_count = handle->rx_overrun_count;
+        _TD1208_end_command(handle, TD1208_ERROR_RX_OVERRUN);
+    }
+    // Match all lines completed since last call with the oldest pending command.
+    while ((handle->command_count != 0) && (handle->line_read_count != handle->line_write_count)) {
+        pending_command = &(handle->command[handle->command_head_idx]);
+        // Update local flag.
+        handle->reply_received = 1;
+        // Read line.
+        line = &(handle->line[handle->line_read_count % TD1208_LINE_INDEX_DEPTH]);
+        kind = line->kind;
+        // The module acknowledges the uplink before opening the downlink window.
+        if ((kind == TD1208_LINE_KIND_OK) && (pending_command->reply_data == TD1208_REPLY_DATA_DOWNLINK)) {
+            handle->uplink_acknowledged = 1;
+        }
+#ifdef TD1208_DRIVER_STATISTICS
+        if (kind == TD1208_LINE_KIND_UNSOLICITED) {
+            handle->statistics.unsolicited_lines_count++;
+        }
+#endif
+        if (handle->reply_data_found == 0) {
+            switch (pending_command->reply_data) {
+            case TD1208_REPLY_DATA_SIGFOX_EP_ID:
+                _TD1208_parse_sigfox_ep_id(handle, line);
+                break;
+            case TD1208_REPLY_DATA_TEXT:
+                if (pending_command->data == NULL) break;
+                _TD1208_parse_text(handle, line, (char_t*) pending_command->data, pending_command->data_size);
+                break;
+            case TD1208_REPLY_DATA_DOWNLINK:
+                if (pending_command->data == NULL) break;
+                _TD1208_parse_downlink(handle, line, (TD1208_downlink_t*) pending_command->data);
+                // Remaining lines of the exchange are drained until the closing line, within a bounded grace period.
+                if ((handle->reply_data_found != 0) && ((handle->elapsed_ms + TD1208_DOWNLINK_END_GRACE_MS) < pending_command->timeout_ms)) {
+                    pending_command->timeout_ms = (handle->elapsed_ms + TD1208_DOWNLINK_END_GRACE_MS);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        // Commands without terminal line kind end with the closing line of the exchange, once reply data has been found.
+        reply_end = ((pending_command->expected_kind == TD1208_LINE_KIND_LAST) && (handle->reply_data_found != 0) && (_TD1208_is_downlink_end(handle, line) != 0)) ? 1 : 0;
+        _TD1208_release_line(handle, line);
+        // Check expected reply, ERROR is always a terminal line.
+        if ((kind == pending_command->expected_kind) || (reply_end != 0)) {
+            _TD1208_end_command(handle, TD1208_SUCCESS);
+        }
+        else if (kind == TD1208_LINE_KIND_ERROR) {
+            _TD1208_end_command(handle, TD1208_ERROR_COMMAND_REJECTED);
+        }
+    }
+    // Manage timeout.
+    if ((handle->command_count != 0) && (handle->elapsed_ms >= handle->command[handle->command_head_idx].timeout_ms)) {
+        if ((handle->command[handle->command_head_idx].expected_kind == TD1208_LINE_KIND_LAST) && (handle->reply_data_found != 0)) {
+            // Closing line not received within the grace period, reply data is valid anyway.
+            _TD1208_end_command(handle, TD1208_SUCCESS);
+        }
+        else if (handle->command[handle->command_head_idx].reply_data == TD1208_REPLY_DATA_DOWNLINK) {
+            // No downlink is reported only if the uplink has been acknowledged, other lines are ignored.
+            _TD1208_end_command(handle, ((handle->uplink_acknowledged != 0) ? TD1208_ERROR_DOWNLINK_TIMEOUT : TD1208_ERROR_REPLY_TIMEOUT));
+        }
+        else if (handle->reply_received == 0) {
+            _TD1208_end_command(handle, TD1208_ERROR_REPLY_TIMEOUT);
+        }
+        else {
+            _TD1208_end_command(handle, TD1208_ERROR_UNEXPECTED_REPLY);
+        }
+    }
+errors:
+    return;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_wait_queue(TD1208_handle_t* handle, uint8_t command_count_max) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint32_t elapsed_ms = 0;
+    while (1) {
+        // Match replies only, the uplink queue is never drained while waiting for the caller commands.
+        _TD1208_process(handle, elapsed_ms);
+        // Check number of pending commands.
+        if (handle->command_count <= command_count_max) goto errors;
+        // Wait for next line.
+        status = _TD1208_wait_event(handle, (handle->command[handle->command_head_idx].timeout_ms - handle->elapsed_ms), &elapsed_ms);
+        if (status != TD1208_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_wait_completion(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Wait for all pending commands, the last completed one is the caller command.
+    status = _TD1208_wait_queue(handle, 0);
+    if (status != TD1208_SUCCESS) goto errors;
+    status = handle->last_command_status;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_execute_command(TD1208_handle_t* handle, TD1208_command_id_t command_id, TD1208_HW_uart_buffer_t* argument) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(NULL, 0, NULL, NULL);
+    // Start command.
+    status = _TD1208_start_descriptor_command(handle, command_id, argument, &pending_command);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+    return status;
+}
+
+#ifdef TD1208_DRIVER_BOOT_PROBING
+/*******************************************************************/
+static TD1208_status_t _TD1208_probe_boot(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_status_t delay_status = TD1208_SUCCESS;
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(NULL, 0, NULL, NULL);
+    uint32_t boot_time_ms = 0;
+    uint32_t probe_time_ms = 0;
+    // Short explicit timeout.
+    pending_command.timeout_ms = TD1208_BOOT_PROBE_PERIOD_MS;
+    // Send AT commands until the module replies OK, bounded by the boot delay.
+    while (boot_time_ms < TD1208_BOOT_DELAY_MS) {
+        probe_time_ms = 0;
+        status = _TD1208_start_descriptor_command(handle, TD1208_COMMAND_ID_AT, NULL, &pending_command);
+        if (status == TD1208_SUCCESS) {
+            status = _TD1208_wait_completion(handle);
+            if (status == TD1208_SUCCESS) break;
+            probe_time_ms = handle->last_command_duration_ms;
+        }
+        // A module which is still booting may fail early (start failure or ERROR reply): wait until the end of the probe period.
+        if (probe_time_ms < TD1208_BOOT_PROBE_PERIOD_MS) {
+            delay_status = _TD1208_delay(handle, (TD1208_BOOT_PROBE_PERIOD_MS - probe_time_ms));
+            if (delay_status != TD1208_SUCCESS) {
+                status = delay_status;
+                break;
+            }
+            probe_time_ms = TD1208_BOOT_PROBE_PERIOD_MS;
+        }
+        boot_time_ms += probe_time_ms;
+    }
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_check_tx_options(const TD1208_tx_options_t* tx_options) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameters.
+    if (tx_options == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (tx_options->repeats > TD1208_TX_REPEATS_MAX) {
+        status = TD1208_ERROR_TX_REPEATS;
+        goto errors;
+    }
+    if ((tx_options->tx_power_enable != 0) && (tx_options->tx_power_dbm > TD1208_TX_POWER_DBM_MAX)) {
+        status = TD1208_ERROR_TX_POWER;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_start_set_tx_power(TD1208_handle_t* handle, const TD1208_tx_options_t* tx_options) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    STRING_status_t string_status = STRING_SUCCESS;
+    char_t tx_power_str[TD1208_TX_POWER_SIZE_CHAR + 1] = { STRING_CHAR_NULL };
+    TD1208_HW_uart_buffer_t argument = { (uint8_t*) tx_power_str, 0 };
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(NULL, 0, &(handle->tx_power_status), NULL);
+    // Build AT command.
+    string_status = STRING_value_to_string((int32_t) tx_options->tx_power_dbm, STRING_FORMAT_DECIMAL, 0, tx_power_str);
+    STRING_exit_error(TD1208_ERROR_BASE_STRING);
+    while (tx_power_str[argument.size_bytes] != STRING_CHAR_NULL) {
+        argument.size_bytes++;
+    }
+    // Queue command before the uplink (the cache is validated by its completion status).
+    status = _TD1208_start_descriptor_command(handle, TD1208_COMMAND_ID_SET_TX_POWER, &argument, &pending_command);
+    if (status != TD1208_SUCCESS) goto errors;
+    handle->tx_power_dbm = tx_options->tx_power_dbm;
+    handle->tx_power_status = TD1208_ERROR_BUSY;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_start_uplink(TD1208_handle_t* handle, TD1208_command_id_t command_id, TD1208_HW_uart_buffer_t* argument, TD1208_pending_command_t* pending_command, const TD1208_tx_options_t* tx_options) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint8_t tx_power_commands_count = 0;
+    // TX power command is skipped if the module already uses the requested power.
+    if ((tx_options->tx_power_enable != 0) && ((handle->tx_power_status != TD1208_SUCCESS) || (handle->tx_power_dbm != tx_options->tx_power_dbm))) {
+        tx_power_commands_count = 1;
+    }
+    // Check queue capacity before sending anything.
+    if ((handle->command_count + tx_power_commands_count) >= TD1208_COMMAND_QUEUE_DEPTH) {
+        status = TD1208_ERROR_BUSY;
+        goto errors;
+    }
+    // Arguments are ready: TX power command is queued right before the uplink, which fails if the power is rejected.
+    if (tx_power_commands_count != 0) {
+        status = _TD1208_start_set_tx_power(handle, tx_options);
+        if (status != TD1208_SUCCESS) goto errors;
+    }
+    pending_command->tx_power_check = tx_power_commands_count;
+    status = _TD1208_start_descriptor_command(handle, command_id, argument, pending_command);
+    if ((status != TD1208_SUCCESS) && (tx_power_commands_count != 0)) {
+        // TX power command has already been sent: keep it queued for its reply but detach it from the cache, so that it is sent again before the next uplink.
+        _TD1208_abort_commands(handle, tx_power_commands_count);
+        handle->tx_power_status = TD1208_ERROR_TX_POWER;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_start_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback, TD1208_status_t* command_status) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    STRING_status_t string_status = STRING_SUCCESS;
+    uint8_t ul_payload_hex_size = (uint8_t) (ul_payload_size_bytes * MATH_U8_SIZE_HEXADECIMAL_DIGITS);
+    TD1208_HW_uart_buffer_t argument = { (uint8_t*) handle->ul_payload_hex, (uint32_t) (ul_payload_hex_size + TD1208_TX_REPEATS_SIZE_CHAR) };
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(downlink, sizeof(TD1208_downlink_t), command_status, completion_callback);
+    // Check parameters.
+    if (ul_payload == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (ul_payload_size_bytes > TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX) {
+        status = TD1208_ERROR_SIGFOX_UL_PAYLOAD_SIZE;
+        goto errors;
+    }
+    status = _TD1208_check_tx_options(tx_options);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Check state before using TX buffer.
+    if (handle->command_count != 0) {
+        status = TD1208_ERROR_BUSY;
+        goto errors;
+    }
+    // Encode payload and repeats directly in TX buffer.
+    string_status = STRING_byte_array_to_hexadecimal_string(ul_payload, ul_payload_size_bytes, 0, handle->ul_payload_hex);
+    STRING_exit_error(TD1208_ERROR_BASE_STRING);
+    handle->ul_payload_hex[ul_payload_hex_size] = ',';
+    handle->ul_payload_hex[ul_payload_hex_size + 1] = (char_t) ('0' + tx_options->repeats);
+    // Full repeats are the module default: keep the plain AT$SF=<payload> command (the downlink request needs the repeats count before it).
+    if ((downlink == NULL) && (tx_options->repeats == TD1208_TX_REPEATS_MAX)) {
+        argument.size_bytes = ul_payload_hex_size;
+    }
+    // Profile timeout is learned with full repeats only.
+    if (tx_options->repeats != TD1208_TX_REPEATS_MAX) {
+        pending_command.timeout_ms = _TD1208_get_timeout(handle, ((downlink != NULL) ? TD1208_TIMEOUT_PROFILE_DOWNLINK : TD1208_TIMEOUT_PROFILE_UPLINK));
+    }
+    // Send commands.
+    status = _TD1208_start_uplink(handle, ((downlink != NULL) ? TD1208_COMMAND_ID_SEND_FRAME_DOWNLINK : TD1208_COMMAND_ID_SEND_FRAME), &argument, &pending_command, tx_options);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*******************************************************************/
+static uint8_t _TD1208_is_uplink_before(TD1208_uplink_t* uplink, TD1208_uplink_t* reference) {
+    // Local variables.
+    uint8_t before = 0;
+    // Priority first, then deadline, then enqueuing order.
+    if (uplink->priority != reference->priority) {
+        before = (uplink->priority > reference->priority);
+    }
+    else if (uplink->deadline_enable != reference->deadline_enable) {
+        before = (uplink->deadline_enable != 0);
+    }
+    else if ((uplink->deadline_enable != 0) && (uplink->deadline_ms != reference->deadline_ms)) {
+        before = (((int32_t) (uplink->deadline_ms - reference->deadline_ms)) < 0);
+    }
+    else {
+        before = (((int32_t) (uplink->sequence - reference->sequence)) < 0);
+    }
+    return before;
+}
+
+/*******************************************************************/
+static void _TD1208_remove_uplink(TD1208_handle_t* handle, uint8_t uplink_idx) {
+    // Queue is unsorted: move last entry in the free slot.
+    handle->uplink_count--;
+    handle->uplink[uplink_idx] = handle->uplink[handle->uplink_count];
+}
+
+/*******************************************************************/
+static void _TD1208_drop_expired_uplinks(TD1208_handle_t* handle) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Remove entries whose deadline is over.
+    while (idx < handle->uplink_count) {
+        if ((handle->uplink[idx].deadline_enable != 0) && (((int32_t) (handle->uplink_time_ms - handle->uplink[idx].deadline_ms)) > 0)) {
+            _TD1208_remove_uplink(handle, idx);
+            handle->uplink_queue_status.dropped_expired_count++;
+        }
+        else {
+            idx++;
+        }
+    }
+}
+
+/*******************************************************************/
+static void _TD1208_build_uplink_frame(TD1208_handle_t* handle) {
+    // Local variables.
+    uint8_t uplink_idx = 0;
+    uint8_t coalescing_enable = 0;
+    uint8_t idx = 0;
+    // Select the most urgent entry.
+    for (idx = 1; idx < handle->uplink_count; idx++) {
+        if (_TD1208_is_uplink_before(&(handle->uplink[idx]), &(handle->uplink[uplink_idx])) != 0) {
+            uplink_idx = idx;
+        }
+    }
+    for (idx = 0; idx < handle->uplink[uplink_idx].ul_payload_size_bytes; idx++) {
+        handle->uplink_frame[idx] = handle->uplink[uplink_idx].ul_payload[idx];
+    }
+    handle->uplink_frame_size_bytes = handle->uplink[uplink_idx].ul_payload_size_bytes;
+    coalescing_enable = handle->uplink[uplink_idx].coalescing_enable;
+    _TD1208_remove_uplink(handle, uplink_idx);
+    // Append the most urgent coalescable entries which fit in the remaining space (no framing is added, coalescable payloads are self-delimiting).
+    while (coalescing_enable != 0) {
+        uplink_idx = handle->uplink_count;
+        for (idx = 0; idx < handle->uplink_count; idx++) {
+            if ((handle->uplink[idx].coalescing_enable == 0) || ((handle->uplink_frame_size_bytes + handle->uplink[idx].ul_payload_size_bytes) > TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX)) continue;
+            if ((uplink_idx == handle->uplink_count) || (_TD1208_is_uplink_before(&(handle->uplink[idx]), &(handle->uplink[uplink_idx])) != 0)) {
+                uplink_idx = idx;
+            }
+        }
+        if (uplink_idx == handle->uplink_count) break;
+        for (idx = 0; idx < handle->uplink[uplink_idx].ul_payload_size_bytes; idx++) {
+            handle->uplink_frame[handle->uplink_frame_size_bytes++] = handle->uplink[uplink_idx].ul_payload[idx];
+        }
+        _TD1208_remove_uplink(handle, uplink_idx);
+        handle->uplink_queue_status.coalesced_count++;
+    }
+    handle->uplink_frame_retries = 0;
+    handle->uplink_frame_pending = 1;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_schedule_uplink(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check outcome of the last frame.
+    if (handle->uplink_frame_in_flight != 0) {
+        handle->uplink_frame_in_flight = 0;
+        if (handle->uplink_frame_status == TD1208_SUCCESS) {
+            handle->uplink_queue_status.frames_sent_count++;
+            handle->uplink_frame_pending = 0;
+        }
+        else {
+            handle->uplink_queue_status.frames_failed_count++;
+            if (handle->uplink_frame_retries < TD1208_UPLINK_RETRIES_MAX) {
+                handle->uplink_frame_retries++;
+                handle->uplink_queue_status.retries_count++;
+            }
+            else {
+                handle->uplink_frame_pending = 0;
+                handle->uplink_queue_status.dropped_retries_count++;
+            }
+        }
+    }
+    _TD1208_drop_expired_uplinks(handle);
+    // Check messages budget (retries are also counted since the frame may have been transmitted).
+    if (handle->uplink_credit_ms < handle->uplink_period_ms) goto errors;
+    if (handle->uplink_frame_pending == 0) {
+        if (handle->uplink_count == 0) goto errors;
+        _TD1208_build_uplink_frame(handle);
+    }
+    status = _TD1208_start_send_frame(handle, handle->uplink_frame, handle->uplink_frame_size_bytes, &TD1208_TX_OPTIONS_DEFAULT, NULL, NULL, &(handle->uplink_frame_status));
+    if (status != TD1208_SUCCESS) goto errors;
+    handle->uplink_credit_ms -= handle->uplink_period_ms;
+    handle->uplink_frame_in_flight = 1;
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_execute_set_baud_rate(TD1208_handle_t* handle, uint32_t baud_rate) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    STRING_status_t string_status = STRING_SUCCESS;
+    char_t baud_rate_str[TD1208_UART_BAUD_RATE_SIZE_CHAR + 1] = { STRING_CHAR_NULL };
+    uint8_t baud_rate_str_size = 0;
+    TD1208_HW_uart_buffer_t argument = { (uint8_t*) baud_rate_str, 0 };
+    // Build AT command (value range is checked by the caller).
+    string_status = STRING_value_to_string((int32_t) baud_rate, STRING_FORMAT_DECIMAL, 0, baud_rate_str);
+    STRING_exit_error(TD1208_ERROR_BASE_STRING);
+    while (baud_rate_str[baud_rate_str_size] != STRING_CHAR_NULL) {
+        baud_rate_str_size++;
+    }
+    argument.size_bytes = baud_rate_str_size;
+    // Configure module (the reply is sent with the current baud rate).
+    status = _TD1208_execute_command(handle, TD1208_COMMAND_ID_SET_BAUD_RATE, &argument);
+errors:
+    return status;
+}
+
+/*** TD1208 functions ***/
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_init(TD1208_handle_t* handle, const TD1208_HW_ops_t* hw_ops, void* hw_context) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_HW_configuration_t hw_config;
+    uint8_t module_powered = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((handle == NULL) || (hw_ops == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((hw_ops->init == NULL) || (hw_ops->de_init == NULL) || (hw_ops->uart_write == NULL) || (hw_ops->delay_milliseconds == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Init context.
+    handle->hw_ops = hw_ops;
+    handle->hw_context = hw_context;
+    handle->rx_write_idx = 0;
+    handle->rx_read_idx = 0;
+    handle->rx_overrun_count = 0;
+    handle->rx_overrun_read_count = 0;
+    handle->line_write_count = 0;
+    handle->line_read_count = 0;
+    handle->line_start_idx = 0;
+    handle->line_flags = TD1208_LINE_FLAGS_RESET;
+    handle->command_head_idx = 0;
+    handle->command_count = 0;
+    handle->sigfox_ep_id_valid = 0;
+    handle->module_info_valid = 0;
+    handle->tx_power_dbm = 0;
+    handle->tx_power_status = TD1208_ERROR_TX_POWER;
+    handle->last_command_duration_ms = 0;
+    handle->uart_baud_rate = TD1208_UART_BAUD_RATE;
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+    handle->uplink_count = 0;
+    handle->uplink_sequence = 0;
+    handle->uplink_time_ms = 0;
+    handle->uplink_period_ms = (TD1208_UPLINK_BUDGET_WINDOW_MS / TD1208_UPLINK_BUDGET_DEFAULT);
+    handle->uplink_credit_ms = TD1208_UPLINK_BUDGET_WINDOW_MS;
+    handle->uplink_frame_pending = 0;
+    handle->uplink_frame_in_flight = 0;
+    handle->uplink_queue_status = td1208_uplink_queue_status_reset;
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    handle->capture_write_idx = 0;
+    handle->capture_read_idx = 0;
+    handle->capture_dropped_records_count = 0;
+    handle->capture_time_ms = 0;
+    handle->capture_clock_ms = 0;
+    handle->capture_rx_chunk_size = 0;
+#endif
+    for (idx = 0; idx < TD1208_TIMEOUT_PROFILE_LAST; idx++) {
+        handle->timeout_ms[idx] = TD1208_TIMEOUT_MS[idx];
+#ifdef TD1208_DRIVER_TIMEOUT_LEARNING
+        handle->timeout_learned_latency_ms[idx] = 0;
+        handle->timeout_learned_samples[idx] = 0;
+#endif
+    }
+#ifdef TD1208_DRIVER_STATISTICS
+    handle->statistics = td1208_statistics_reset;
+    handle->statistics.command_latency_min_ms = TD1208_STATISTICS_LATENCY_MIN_RESET;
+    handle->statistics_rx_bytes_count = 0;
+    handle->statistics_rx_buffer_wrap_count = 0;
+    handle->statistics_rx_overrun_count = 0;
+    handle->statistics_time_ms = 0;
+    handle->statistics_latency_total_ms = 0;
+#endif
+    // Init hardware interface.
+    hw_config.uart_baud_rate = TD1208_UART_BAUD_RATE;
+    hw_config.rx_irq_callback = (handle == &td1208_default_handle) ? &_TD1208_rx_irq_callback : NULL;
+    hw_config.handle = handle;
+    hw_config.instance_rx_irq_callback = &_TD1208_instance_rx_irq_callback;
+#ifdef TD1208_DRIVER_RX_BLOCK_MODE
+    hw_config.rx_block_buffer = handle->rx_block_buffer;
+    hw_config.rx_block_buffer_size_bytes = TD1208_RX_BLOCK_BUFFER_SIZE_BYTES;
+    hw_config.rx_block_callback = (handle == &td1208_default_handle) ? &_TD1208_rx_block_callback : NULL;
+    hw_config.instance_rx_block_callback = &_TD1208_instance_rx_block_callback;
+#endif
+    status = handle->hw_ops->init(handle->hw_context, &hw_config);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Skip boot sequence on warm start.
+    if ((handle->hw_ops->get_power_state != NULL) && (handle->hw_ops->get_power_state(handle->hw_context, &module_powered) == TD1208_SUCCESS) && (module_powered != 0)) goto errors;
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+#ifdef TD1208_DRIVER_BOOT_PROBING
+    // Wait for module readiness.
+    status = _TD1208_probe_boot(handle);
+#else
+    // Boot delay.
+    status = _TD1208_delay(handle, TD1208_BOOT_DELAY_MS);
+#endif
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_de_init(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Wait for the current transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Abort pending commands.
+    while (handle->command_count != 0) {
+        _TD1208_end_command(handle, TD1208_ERROR_COMMAND_ABORTED);
+    }
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+    // Aborted frame is not retried.
+    if (handle->uplink_frame_in_flight != 0) {
+        handle->uplink_frame_in_flight = 0;
+        handle->uplink_frame_pending = 0;
+        handle->uplink_queue_status.frames_failed_count++;
+    }
+#endif
+    // Invalidate cache.
+    handle->sigfox_ep_id_valid = 0;
+    handle->module_info_valid = 0;
+    handle->tx_power_status = TD1208_ERROR_TX_POWER;
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    status = handle->hw_ops->de_init(handle->hw_context);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_set_baud_rate(TD1208_handle_t* handle, uint32_t baud_rate) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint32_t previous_baud_rate = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameter.
+    if ((baud_rate < TD1208_UART_BAUD_RATE_MIN) || (baud_rate > TD1208_UART_BAUD_RATE_MAX)) {
+        status = TD1208_ERROR_BAUD_RATE;
+        goto errors;
+    }
+    // Check state.
+    if (handle->command_count != 0) {
+        status = TD1208_ERROR_BUSY;
+        goto errors;
+    }
+    // Check that the hardware interface supports baud rate update before changing module configuration.
+    previous_baud_rate = handle->uart_baud_rate;
+    status = _TD1208_set_hw_baud_rate(handle, previous_baud_rate);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Configure module.
+    status = _TD1208_execute_set_baud_rate(handle, baud_rate);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Switch hardware interface.
+    status = _TD1208_set_hw_baud_rate(handle, baud_rate);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Verify link.
+    status = _TD1208_execute_command(handle, TD1208_COMMAND_ID_AT, NULL);
+    if (status != TD1208_SUCCESS) {
+        // Restore previous module configuration (the command may be understood even if the probe failed, so its status is ignored).
+        _TD1208_execute_set_baud_rate(handle, previous_baud_rate);
+        // Fall back to previous baud rate.
+        status = _TD1208_set_hw_baud_rate(handle, previous_baud_rate);
+        if (status != TD1208_SUCCESS) goto errors;
+        // Verify that the link is recovered.
+        status = _TD1208_execute_command(handle, TD1208_COMMAND_ID_AT, NULL);
+        if (status != TD1208_SUCCESS) goto errors;
+        status = TD1208_ERROR_BAUD_RATE;
+        goto errors;
+    }
+    // Update context.
+    handle->uart_baud_rate = baud_rate;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_set_timeout(TD1208_handle_t* handle, TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameters.
+    if ((timeout_profile >= TD1208_TIMEOUT_PROFILE_LAST) || (timeout_ms == 0)) {
+        status = TD1208_ERROR_TIMEOUT_PROFILE;
+        goto errors;
+    }
+    handle->timeout_ms[timeout_profile] = timeout_ms;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_reset(TD1208_handle_t* handle, TD1208_completion_cb_t completion_callback) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(NULL, 0, NULL, completion_callback);
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Invalidate cache.
+    handle->sigfox_ep_id_valid = 0;
+    handle->module_info_valid = 0;
+    handle->tx_power_status = TD1208_ERROR_TX_POWER;
+    // Send command.
+    status = _TD1208_start_descriptor_command(handle, TD1208_COMMAND_ID_ATZ, NULL, &pending_command);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(sigfox_ep_id, TD1208_SIGFOX_EP_ID_SIZE_BYTES, NULL, completion_callback);
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameter.
+    if (sigfox_ep_id == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Use cache if possible.
+    if (handle->sigfox_ep_id_valid != 0) {
+        _TD1208_copy_sigfox_ep_id(handle, sigfox_ep_id);
+        if (completion_callback != NULL) {
+            completion_callback(handle, TD1208_SUCCESS);
+        }
+        goto errors;
+    }
+    // Send command.
+    status = _TD1208_start_descriptor_command(handle, TD1208_COMMAND_ID_ATI7, NULL, &pending_command);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_send_bit(TD1208_handle_t* handle, uint8_t ul_bit, TD1208_completion_cb_t completion_callback) {
+    // Full repeats and current TX power.
+    return TD1208_instance_start_send_bit_with_options(handle, ul_bit, &TD1208_TX_OPTIONS_DEFAULT, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback) {
+    // Full repeats and current TX power.
+    return TD1208_instance_start_send_frame_with_options(handle, ul_payload, ul_payload_size_bytes, &TD1208_TX_OPTIONS_DEFAULT, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameter.
+    if (downlink == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    status = _TD1208_start_send_frame(handle, ul_payload, ul_payload_size_bytes, &TD1208_TX_OPTIONS_DEFAULT, downlink, completion_callback, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    char_t bit_str[TD1208_SEND_BIT_ARGUMENT_SIZE_CHAR];
+    TD1208_HW_uart_buffer_t argument = { (uint8_t*) bit_str, TD1208_SEND_BIT_ARGUMENT_SIZE_CHAR };
+    TD1208_pending_command_t pending_command = TD1208_PENDING_COMMAND(NULL, 0, NULL, completion_callback);
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameter.
+    status = _TD1208_check_tx_options(tx_options);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Build argument.
+    bit_str[0] = ((ul_bit != 0) ? '1' : '0');
+    bit_str[1] = ',';
+    bit_str[2] = (char_t) ('0' + tx_options->repeats);
+    // Profile timeout is learned with full repeats only.
+    if (tx_options->repeats != TD1208_TX_REPEATS_MAX) {
+        pending_command.timeout_ms = _TD1208_get_timeout(handle, TD1208_TIMEOUT_PROFILE_UPLINK);
+    }
+    // Send commands.
+    status = _TD1208_start_uplink(handle, TD1208_COMMAND_ID_SEND_BIT, &argument, &pending_command, tx_options);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_start_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Uplink only.
+    status = _TD1208_start_send_frame(handle, ul_payload, ul_payload_size_bytes, tx_options, NULL, completion_callback, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_process(TD1208_handle_t* handle, uint32_t elapsed_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    _TD1208_process(handle, elapsed_ms);
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+    // Drain uplink queue when the driver is idle.
+    if (handle->command_count == 0) {
+        status = _TD1208_schedule_uplink(handle);
+    }
+#endif
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_execute_batch(TD1208_handle_t* handle, TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_HW_uart_buffer_t command[2] = {
+        { NULL, 0 },
+        TD1208_COMMAND_SEGMENT("\r")
+    };
+    TD1208_pending_command_t pending_command = { TD1208_LINE_KIND_OK, 0, TD1208_TIMEOUT_PROFILE_COMMAND, TD1208_REPLY_DATA_NONE, NULL, 0, NULL, NULL, 0 };
+    uint8_t idx = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameters.
+    if ((commands == NULL) || (commands_status == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    for (idx = 0; idx < commands_count; idx++) {
+        if (commands[idx].command == NULL) {
+            status = TD1208_ERROR_NULL_PARAMETER;
+            goto errors;
+        }
+        commands_status[idx] = TD1208_ERROR_REPLY_TIMEOUT;
+    }
+    // Send all commands.
+    for (idx = 0; idx < commands_count; idx++) {
+        // Wait for a free slot in queue.
+        status = _TD1208_wait_queue(handle, TD1208_COMMAND_QUEUE_DEPTH - 1);
+        if (status != TD1208_SUCCESS) {
+            _TD1208_abort_commands(handle, idx);
+            goto errors;
+        }
+        // Build command.
+        command[0].data = (uint8_t*) commands[idx].command;
+        command[0].size_bytes = 0;
+        while (commands[idx].command[command[0].size_bytes] != STRING_CHAR_NULL) {
+            command[0].size_bytes++;
+        }
+        pending_command.expected_kind = commands[idx].expected_reply;
+        pending_command.timeout_ms = commands[idx].timeout_ms;
+        pending_command.status = &(commands_status[idx]);
+        // Send command.
+        status = _TD1208_start_command(handle, command, 2, &pending_command);
+        if (status != TD1208_SUCCESS) {
+            _TD1208_abort_commands(handle, idx);
+            goto errors;
+        }
+    }
+    // Wait for last replies.
+    status = _TD1208_wait_queue(handle, 0);
+    if (status != TD1208_SUCCESS) {
+        _TD1208_abort_commands(handle, commands_count);
+        goto errors;
+    }
+    // Return first command error if any.
+    for (idx = 0; idx < commands_count; idx++) {
+        if (commands_status[idx] != TD1208_SUCCESS) {
+            status = commands_status[idx];
+            break;
+        }
+    }
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_reset(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Start command.
+    status = TD1208_instance_start_reset(handle, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_get_sigfox_ep_id(TD1208_handle_t* handle, uint8_t* sigfox_ep_id) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Start command.
+    status = TD1208_instance_start_get_sigfox_ep_id(handle, sigfox_ep_id, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Nothing to wait if the ID has been read from cache.
+    if (handle->sigfox_ep_id_valid != 0) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_get_module_info(TD1208_handle_t* handle, TD1208_module_info_t* module_info) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_command_id_t command_id[TD1208_MODULE_INFO_COMMANDS_COUNT] = { TD1208_COMMAND_ID_ATI7, TD1208_COMMAND_ID_ATI11, TD1208_COMMAND_ID_ATI13 };
+    TD1208_status_t commands_status[TD1208_MODULE_INFO_COMMANDS_COUNT];
+    TD1208_pending_command_t pending_command[TD1208_MODULE_INFO_COMMANDS_COUNT] = {
+        TD1208_PENDING_COMMAND(NULL, TD1208_SIGFOX_EP_ID_SIZE_BYTES, &(commands_status[0]), NULL),
+        TD1208_PENDING_COMMAND(NULL, TD1208_MODULE_INFO_REVISION_SIZE_CHAR, &(commands_status[1]), NULL),
+        TD1208_PENDING_COMMAND(NULL, TD1208_MODULE_INFO_REVISION_SIZE_CHAR, &(commands_status[2]), NULL)
+    };
+    uint8_t idx = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Check parameter.
+    if (module_info == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read module if cache is not valid.
+    if (handle->module_info_valid == 0) {
+        pending_command[0].data = handle->module_info.sigfox_ep_id;
+        pending_command[1].data = (uint8_t*) handle->module_info.hardware_revision;
+        pending_command[2].data = (uint8_t*) handle->module_info.firmware_revision;
+        // Send all queries.
+        for (idx = 0; idx < TD1208_MODULE_INFO_COMMANDS_COUNT; idx++) {
+            status = _TD1208_wait_queue(handle, TD1208_COMMAND_QUEUE_DEPTH - 1);
+            if (status != TD1208_SUCCESS) {
+                _TD1208_abort_commands(handle, idx);
+                goto errors;
+            }
+            status = _TD1208_start_descriptor_command(handle, command_id[idx], NULL, &(pending_command[idx]));
+            if (status != TD1208_SUCCESS) {
+                _TD1208_abort_commands(handle, idx);
+                goto errors;
+            }
+        }
+        // Wait for replies.
+        status = _TD1208_wait_queue(handle, 0);
+        if (status != TD1208_SUCCESS) {
+            _TD1208_abort_commands(handle, TD1208_MODULE_INFO_COMMANDS_COUNT);
+            goto errors;
+        }
+        for (idx = 0; idx < TD1208_MODULE_INFO_COMMANDS_COUNT; idx++) {
+            status = commands_status[idx];
+            if (status != TD1208_SUCCESS) goto errors;
+        }
+        handle->module_info_valid = 1;
+    }
+    // Copy cache.
+    (*module_info) = handle->module_info;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_invalidate_module_info(TD1208_handle_t* handle) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Next queries will read the module.
+    handle->sigfox_ep_id_valid = 0;
+    handle->module_info_valid = 0;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_send_bit(TD1208_handle_t* handle, uint8_t ul_bit) {
+    // Full repeats and current TX power.
+    return TD1208_instance_send_bit_with_options(handle, ul_bit, &TD1208_TX_OPTIONS_DEFAULT);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_send_frame(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes) {
+    // Full repeats and current TX power.
+    return TD1208_instance_send_frame_with_options(handle, ul_payload, ul_payload_size_bytes, &TD1208_TX_OPTIONS_DEFAULT);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_send_frame_with_downlink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Start command.
+    status = TD1208_instance_start_send_frame_with_downlink(handle, ul_payload, ul_payload_size_bytes, downlink, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_send_bit_with_options(TD1208_handle_t* handle, uint8_t ul_bit, const TD1208_tx_options_t* tx_options) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Start command.
+    status = TD1208_instance_start_send_bit_with_options(handle, ul_bit, tx_options, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_send_frame_with_options(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Serialize transaction.
+    _TD1208_begin_transaction(handle);
+#endif
+    // Start command.
+    status = TD1208_instance_start_send_frame_with_options(handle, ul_payload, ul_payload_size_bytes, tx_options, NULL);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Wait for command completion.
+    status = _TD1208_wait_completion(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_end_transaction(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_get_last_command_duration(TD1208_handle_t* handle, uint32_t* duration_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameter.
+    if (duration_ms == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*duration_ms) = handle->last_command_duration_ms;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+
+#ifdef TD1208_DRIVER_STATISTICS
+/*******************************************************************/
+TD1208_status_t TD1208_instance_get_statistics(TD1208_handle_t* handle, TD1208_statistics_t* statistics) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint32_t completed_count = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameter.
+    if (statistics == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy counters.
+    (*statistics) = handle->statistics;
+    statistics->rx_bytes_count = handle->statistics_rx_bytes_count;
+    statistics->rx_buffer_wrap_count = handle->statistics_rx_buffer_wrap_count;
+    statistics->rx_overrun_count = handle->statistics_rx_overrun_count;
+    // Compute latency.
+    completed_count = (statistics->commands_success_count + statistics->commands_timeout_count + statistics->commands_unexpected_reply_count + statistics->commands_rx_overrun_count + statistics->commands_rejected_count + statistics->commands_other_error_count);
+    if (completed_count == 0) {
+        statistics->command_latency_min_ms = 0;
+    }
+    else {
+        statistics->command_latency_average_ms = (handle->statistics_latency_total_ms / completed_count);
+    }
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*******************************************************************/
+TD1208_status_t TD1208_instance_enqueue_uplink(TD1208_handle_t* handle, uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_uplink_t uplink;
+    uint8_t uplink_idx = 0;
+    uint8_t idx = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameters.
+    if ((ul_payload == NULL) || (parameters == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (ul_payload_size_bytes > TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX) {
+        status = TD1208_ERROR_SIGFOX_UL_PAYLOAD_SIZE;
+        goto errors;
+    }
+    // Build entry.
+    for (idx = 0; idx < ul_payload_size_bytes; idx++) {
+        uplink.ul_payload[idx] = ul_payload[idx];
+    }
+    uplink.ul_payload_size_bytes = ul_payload_size_bytes;
+    uplink.priority = parameters->priority;
+    uplink.coalescing_enable = parameters->coalescing_enable;
+    uplink.deadline_enable = (parameters->deadline_ms != 0);
+    uplink.deadline_ms = (handle->uplink_time_ms + parameters->deadline_ms);
+    uplink.sequence = handle->uplink_sequence;
+    // Select slot.
+    if (handle->uplink_count < TD1208_UPLINK_QUEUE_DEPTH) {
+        uplink_idx = handle->uplink_count;
+        handle->uplink_count++;
+    }
+    else {
+        // Replace the least urgent entry if the new one is more urgent.
+        for (idx = 1; idx < TD1208_UPLINK_QUEUE_DEPTH; idx++) {
+            if (_TD1208_is_uplink_before(&(handle->uplink[uplink_idx]), &(handle->uplink[idx])) != 0) {
+                uplink_idx = idx;
+            }
+        }
+        handle->uplink_queue_status.dropped_full_count++;
+        if (_TD1208_is_uplink_before(&uplink, &(handle->uplink[uplink_idx])) == 0) {
+            status = TD1208_ERROR_UPLINK_QUEUE_FULL;
+            goto errors;
+        }
+    }
+    handle->uplink[uplink_idx] = uplink;
+    handle->uplink_sequence++;
+    handle->uplink_queue_status.enqueued_count++;
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_set_uplink_budget(TD1208_handle_t* handle, uint8_t messages_per_hour) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Update messages period (budget 0 pauses the queue).
+    handle->uplink_period_ms = (messages_per_hour == 0) ? TD1208_UPLINK_PERIOD_DISABLED : (TD1208_UPLINK_BUDGET_WINDOW_MS / messages_per_hour);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_instance_get_uplink_queue_status(TD1208_handle_t* handle, TD1208_uplink_queue_status_t* uplink_queue_status) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameter.
+    if (uplink_queue_status == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy counters.
+    (*uplink_queue_status) = handle->uplink_queue_status;
+    uplink_queue_status->queue_depth = handle->uplink_count;
+    uplink_queue_status->budget_remaining = (uint8_t) (handle->uplink_credit_ms / handle->uplink_period_ms);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+TD1208_status_t TD1208_instance_read_capture(TD1208_handle_t* handle, uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    uint16_t record_size = 0;
+    uint16_t idx = 0;
+    // Check handle.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    // Protect handle state (never held while waiting for the module).
+    _TD1208_lock(handle);
+#endif
+    // Check parameters.
+    if ((data == NULL) || (read_size_bytes == NULL) || (dropped_records_count == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*read_size_bytes) = 0;
+    // Records are also written under interrupt.
+    _TD1208_enter_critical(handle);
+    // Copy complete records only.
+    while (handle->capture_read_idx != handle->capture_write_idx) {
+        record_size = _TD1208_get_capture_record_size(handle, handle->capture_read_idx);
+        if (((*read_size_bytes) + record_size) > data_size_bytes) break;
+        for (idx = 0; idx < record_size; idx++) {
+            data[(*read_size_bytes)++] = handle->capture_buffer[(uint16_t) (handle->capture_read_idx + idx) % TD1208_CAPTURE_BUFFER_SIZE_BYTES];
+        }
+        handle->capture_read_idx = (uint16_t) (handle->capture_read_idx + record_size);
+    }
+    (*dropped_records_count) = handle->capture_dropped_records_count;
+    handle->capture_dropped_records_count = 0;
+    _TD1208_exit_critical(handle);
+errors:
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    _TD1208_unlock(handle);
+#endif
+    return status;
+}
+#endif
+
+/*** TD1208 default instance functions ***/
+
+/*******************************************************************/
+TD1208_status_t TD1208_init(void) {
+    // Use weak hardware functions.
+    return TD1208_instance_init(&td1208_default_handle, &TD1208_HW_DEFAULT_OPS, NULL);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_de_init(void) {
+    // Use default instance.
+    return TD1208_instance_de_init(&td1208_default_handle);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_set_baud_rate(uint32_t baud_rate) {
+    // Use default instance.
+    return TD1208_instance_set_baud_rate(&td1208_default_handle, baud_rate);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_set_timeout(TD1208_timeout_profile_t timeout_profile, uint32_t timeout_ms) {
+    // Use default instance.
+    return TD1208_instance_set_timeout(&td1208_default_handle, timeout_profile, timeout_ms);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_reset(TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_reset(&td1208_default_handle, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_get_sigfox_ep_id(uint8_t* sigfox_ep_id, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_get_sigfox_ep_id(&td1208_default_handle, sigfox_ep_id, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_send_bit(uint8_t ul_bit, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_send_bit(&td1208_default_handle, ul_bit, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_send_frame(&td1208_default_handle, ul_payload, ul_payload_size_bytes, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_send_frame_with_downlink(&td1208_default_handle, ul_payload, ul_payload_size_bytes, downlink, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_send_bit_with_options(&td1208_default_handle, ul_bit, tx_options, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_start_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options, TD1208_completion_cb_t completion_callback) {
+    // Use default instance.
+    return TD1208_instance_start_send_frame_with_options(&td1208_default_handle, ul_payload, ul_payload_size_bytes, tx_options, completion_callback);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_process(uint32_t elapsed_ms) {
+    // Use default instance.
+    return TD1208_instance_process(&td1208_default_handle, elapsed_ms);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_execute_batch(TD1208_command_t* commands, uint8_t commands_count, TD1208_status_t* commands_status) {
+    // Use default instance.
+    return TD1208_instance_execute_batch(&td1208_default_handle, commands, commands_count, commands_status);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_reset(void) {
+    // Use default instance.
+    return TD1208_instance_reset(&td1208_default_handle);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_get_sigfox_ep_id(uint8_t* sigfox_ep_id) {
+    // Use default instance.
+    return TD1208_instance_get_sigfox_ep_id(&td1208_default_handle, sigfox_ep_id);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_get_module_info(TD1208_module_info_t* module_info) {
+    // Use default instance.
+    return TD1208_instance_get_module_info(&td1208_default_handle, module_info);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_invalidate_module_info(void) {
+    // Use default instance.
+    return TD1208_instance_invalidate_module_info(&td1208_default_handle);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_send_bit(uint8_t ul_bit) {
+    // Use default instance.
+    return TD1208_instance_send_bit(&td1208_default_handle, ul_bit);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size_bytes) {
+    // Use default instance.
+    return TD1208_instance_send_frame(&td1208_default_handle, ul_payload, ul_payload_size_bytes);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_send_frame_with_downlink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_downlink_t* downlink) {
+    // Use default instance.
+    return TD1208_instance_send_frame_with_downlink(&td1208_default_handle, ul_payload, ul_payload_size_bytes, downlink);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_send_bit_with_options(uint8_t ul_bit, const TD1208_tx_options_t* tx_options) {
+    // Use default instance.
+    return TD1208_instance_send_bit_with_options(&td1208_default_handle, ul_bit, tx_options);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_send_frame_with_options(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, const TD1208_tx_options_t* tx_options) {
+    // Use default instance.
+    return TD1208_instance_send_frame_with_options(&td1208_default_handle, ul_payload, ul_payload_size_bytes, tx_options);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_get_last_command_duration(uint32_t* duration_ms) {
+    // Use default instance.
+    return TD1208_instance_get_last_command_duration(&td1208_default_handle, duration_ms);
+}
+
+#ifdef TD1208_DRIVER_STATISTICS
+/*******************************************************************/
+TD1208_status_t TD1208_get_statistics(TD1208_statistics_t* statistics) {
+    // Use default instance.
+    return TD1208_instance_get_statistics(&td1208_default_handle, statistics);
+}
+#endif
+
+#ifdef TD1208_DRIVER_UPLINK_QUEUE
+/*******************************************************************/
+TD1208_status_t TD1208_enqueue_uplink(uint8_t* ul_payload, uint8_t ul_payload_size_bytes, TD1208_uplink_parameters_t* parameters) {
+    // Use default instance.
+    return TD1208_instance_enqueue_uplink(&td1208_default_handle, ul_payload, ul_payload_size_bytes, parameters);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_set_uplink_budget(uint8_t messages_per_hour) {
+    // Use default instance.
+    return TD1208_instance_set_uplink_budget(&td1208_default_handle, messages_per_hour);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_get_uplink_queue_status(TD1208_uplink_queue_status_t* uplink_queue_status) {
+    // Use default instance.
+    return TD1208_instance_get_uplink_queue_status(&td1208_default_handle, uplink_queue_status);
+}
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+TD1208_status_t TD1208_read_capture(uint8_t* data, uint32_t data_size_bytes, uint32_t* read_size_bytes, uint32_t* dropped_records_count) {
+    // Use default instance.
+    return TD1208_instance_read_capture(&td1208_default_handle, data, data_size_bytes, read_size_bytes, dropped_records_count);
+}
+#endif
 
 #endif /* TD1208_DRIVER_DISABLE */
@@ -0,0 +1,347 @@
+/*
+ * td1208_codec.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "td1208_codec.h"
+
+#ifndef TD1208_DRIVER_DISABLE_FLAGS_FILE
+#include "td1208_driver_flags.h"
+#endif
+#include "td1208.h"
+#include "types.h"
+
+#ifndef TD1208_DRIVER_DISABLE
+
+/*** TD1208 CODEC local macros ***/
+
+#define TD1208_CODEC_FRAME_SIZE_BITS_MAX    (TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX * 8)
+#define TD1208_CODEC_TYPE_SIZE_BITS         1
+#define TD1208_CODEC_SEQUENCE_SIZE_BITS     3
+#define TD1208_CODEC_SEQUENCE_MASK          ((1 << TD1208_CODEC_SEQUENCE_SIZE_BITS) - 1)
+#define TD1208_CODEC_HEADER_SIZE_BITS       (TD1208_CODEC_TYPE_SIZE_BITS + TD1208_CODEC_SEQUENCE_SIZE_BITS)
+
+#define TD1208_CODEC_HEADER_ABSOLUTE        0
+#define TD1208_CODEC_HEADER_DELTA           1
+
+/*** TD1208 CODEC local functions ***/
+
+/*******************************************************************/
+static uint32_t _TD1208_CODEC_get_code_max(const TD1208_CODEC_field_t* field) {
+    // Number of quantization steps in the range.
+    return (uint32_t) (((int64_t) field->maximum - (int64_t) field->minimum) / (int64_t) field->quantization);
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_CODEC_quantize(const TD1208_CODEC_field_t* field, int32_t value) {
+    // Local variables.
+    int64_t offset = 0;
+    uint32_t code = 0;
+    uint32_t code_max = _TD1208_CODEC_get_code_max(field);
+    // Clamp value.
+    if (value < field->minimum) {
+        value = field->minimum;
+    }
+    if (value > field->maximum) {
+        value = field->maximum;
+    }
+    // Round to the nearest step.
+    offset = ((int64_t) value - (int64_t) field->minimum);
+    code = (uint32_t) ((offset + (int64_t) (field->quantization >> 1)) / (int64_t) field->quantization);
+    return ((code > code_max) ? code_max : code);
+}
+
+/*******************************************************************/
+static int32_t _TD1208_CODEC_dequantize(const TD1208_CODEC_field_t* field, uint32_t code) {
+    // Convert step to value.
+    return (int32_t) ((int64_t) field->minimum + ((int64_t) code * (int64_t) field->quantization));
+}
+
+/*******************************************************************/
+static uint8_t _TD1208_CODEC_is_delta_valid(const TD1208_CODEC_field_t* field, int64_t delta) {
+    // Signed range of the delta field.
+    return ((delta >= -((int64_t) 1 << (field->delta_size_bits - 1))) && (delta < ((int64_t) 1 << (field->delta_size_bits - 1))));
+}
+
+/*******************************************************************/
+static uint16_t _TD1208_CODEC_get_frame_size_bits(const TD1208_CODEC_schema_t* schema, uint8_t header) {
+    // Local variables.
+    uint16_t frame_size_bits = TD1208_CODEC_HEADER_SIZE_BITS;
+    uint8_t idx = 0;
+    // Sum fields size.
+    for (idx = 0; idx < schema->fields_count; idx++) {
+        frame_size_bits = (uint16_t) (frame_size_bits + (((header == TD1208_CODEC_HEADER_DELTA) && (schema->fields[idx].delta_size_bits != 0)) ? schema->fields[idx].delta_size_bits : schema->fields[idx].size_bits));
+    }
+    return frame_size_bits;
+}
+
+/*******************************************************************/
+static void _TD1208_CODEC_write_bits(uint8_t* data, uint8_t* bit_idx, uint32_t value, uint8_t size_bits) {
+    // Local variables.
+    uint8_t idx = 0;
+    // MSB first.
+    for (idx = size_bits; idx > 0; idx--) {
+        if (((value >> (idx - 1)) & 0x01) != 0) {
+            data[(*bit_idx) >> 3] |= (uint8_t) (0x80 >> ((*bit_idx) & 0x07));
+        }
+        (*bit_idx)++;
+    }
+}
+
+/*******************************************************************/
+static uint32_t _TD1208_CODEC_read_bits(const uint8_t* data, uint8_t* bit_idx, uint8_t size_bits) {
+    // Local variables.
+    uint32_t value = 0;
+    uint8_t idx = 0;
+    // MSB first.
+    for (idx = 0; idx < size_bits; idx++) {
+        value = (value << 1) | ((data[(*bit_idx) >> 3] >> (7 - ((*bit_idx) & 0x07))) & 0x01);
+        (*bit_idx)++;
+    }
+    return value;
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_CODEC_send(TD1208_handle_t* handle, TD1208_CODEC_context_t* context, const int32_t* values) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    TD1208_CODEC_frame_t frame;
+    // Encode values.
+    status = TD1208_CODEC_encode(context, values, &frame);
+    if (status != TD1208_SUCCESS) goto errors;
+    // Send uplink on the given instance or on the default one.
+    if (frame.bit_frame != 0) {
+        status = (handle != NULL) ? TD1208_instance_send_bit(handle, frame.ul_bit) : TD1208_send_bit(frame.ul_bit);
+    }
+    else {
+        status = (handle != NULL) ? TD1208_instance_send_frame(handle, frame.ul_payload, frame.ul_payload_size_bytes) : TD1208_send_frame(frame.ul_payload, frame.ul_payload_size_bytes);
+    }
+    // Resynchronize the backend decoder on next frame.
+    if (status != TD1208_SUCCESS) {
+        context->previous_valid = 0;
+    }
+errors:
+    return status;
+}
+
+/*** TD1208 CODEC functions ***/
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_init(TD1208_CODEC_context_t* context, const TD1208_CODEC_schema_t* schema) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    const TD1208_CODEC_field_t* field = NULL;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((context == NULL) || (schema == NULL) || (schema->fields == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((schema->fields_count == 0) || (schema->fields_count > TD1208_CODEC_FIELDS_MAX)) {
+        status = TD1208_ERROR_CODEC_SCHEMA;
+        goto errors;
+    }
+    // Check fields.
+    for (idx = 0; idx < schema->fields_count; idx++) {
+        field = &(schema->fields[idx]);
+        if ((field->size_bits == 0) || (field->size_bits > TD1208_CODEC_FIELD_SIZE_BITS_MAX) || (field->delta_size_bits > field->size_bits) || (field->quantization == 0) || (field->maximum < field->minimum)) {
+            status = TD1208_ERROR_CODEC_SCHEMA;
+            goto errors;
+        }
+        if ((field->size_bits < TD1208_CODEC_FIELD_SIZE_BITS_MAX) && (_TD1208_CODEC_get_code_max(field) >= ((uint32_t) 1 << field->size_bits))) {
+            status = TD1208_ERROR_CODEC_SCHEMA;
+            goto errors;
+        }
+    }
+    // Single bit uplinks carry no sequence number: the fast flag must be sent in absolute form in delta frames so that a lost bit is corrected by the next frame.
+    if ((schema->fast_flag_field_idx != TD1208_CODEC_FAST_FLAG_NONE) && ((schema->fast_flag_field_idx >= schema->fields_count) || (schema->fields[schema->fast_flag_field_idx].size_bits != 1) || (schema->fields[schema->fast_flag_field_idx].delta_size_bits != 0))) {
+        status = TD1208_ERROR_CODEC_SCHEMA;
+        goto errors;
+    }
+    // Check frame size (delta frames are never larger than absolute frames).
+    if (_TD1208_CODEC_get_frame_size_bits(schema, TD1208_CODEC_HEADER_ABSOLUTE) > TD1208_CODEC_FRAME_SIZE_BITS_MAX) {
+        status = TD1208_ERROR_CODEC_SCHEMA;
+        goto errors;
+    }
+    // Reset state.
+    context->schema = schema;
+    context->previous_valid = 0;
+    context->delta_frames_count = 0;
+    context->sequence = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_force_keyframe(TD1208_CODEC_context_t* context) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    context->previous_valid = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_encode(TD1208_CODEC_context_t* context, const int32_t* values, TD1208_CODEC_frame_t* frame) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    const TD1208_CODEC_schema_t* schema = NULL;
+    const TD1208_CODEC_field_t* field = NULL;
+    uint32_t code[TD1208_CODEC_FIELDS_MAX];
+    uint8_t header = TD1208_CODEC_HEADER_ABSOLUTE;
+    uint8_t changes_count = 0;
+    uint8_t changed_field_idx = 0;
+    uint8_t bit_idx = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((context == NULL) || (context->schema == NULL) || (values == NULL) || (frame == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    schema = context->schema;
+    // Quantize values and check delta encoding.
+    header = ((context->previous_valid != 0) && (context->delta_frames_count < schema->keyframe_period)) ? TD1208_CODEC_HEADER_DELTA : TD1208_CODEC_HEADER_ABSOLUTE;
+    for (idx = 0; idx < schema->fields_count; idx++) {
+        field = &(schema->fields[idx]);
+        code[idx] = _TD1208_CODEC_quantize(field, values[idx]);
+        if ((context->previous_valid != 0) && (code[idx] != context->previous_code[idx])) {
+            changes_count++;
+            changed_field_idx = idx;
+        }
+        if ((header == TD1208_CODEC_HEADER_DELTA) && (field->delta_size_bits != 0) && (_TD1208_CODEC_is_delta_valid(field, ((int64_t) code[idx] - (int64_t) context->previous_code[idx])) == 0)) {
+            header = TD1208_CODEC_HEADER_ABSOLUTE;
+        }
+    }
+    // Reset frame.
+    for (idx = 0; idx < TD1208_SIGFOX_UL_PAYLOAD_SIZE_BYTES_MAX; idx++) {
+        frame->ul_payload[idx] = 0;
+    }
+    frame->ul_payload_size_bytes = 0;
+    frame->bit_frame = 0;
+    frame->ul_bit = 0;
+    // Single bit uplink when the fast flag is the only change.
+    if ((context->previous_valid != 0) && (schema->fast_flag_field_idx != TD1208_CODEC_FAST_FLAG_NONE) && (changes_count == 1) && (changed_field_idx == schema->fast_flag_field_idx)) {
+        frame->bit_frame = 1;
+        frame->ul_bit = (uint8_t) code[changed_field_idx];
+        context->previous_code[changed_field_idx] = code[changed_field_idx];
+        goto errors;
+    }
+    // Pack header (type and rolling sequence number) and fields.
+    _TD1208_CODEC_write_bits(frame->ul_payload, &bit_idx, header, TD1208_CODEC_TYPE_SIZE_BITS);
+    _TD1208_CODEC_write_bits(frame->ul_payload, &bit_idx, context->sequence, TD1208_CODEC_SEQUENCE_SIZE_BITS);
+    for (idx = 0; idx < schema->fields_count; idx++) {
+        field = &(schema->fields[idx]);
+        if ((header == TD1208_CODEC_HEADER_DELTA) && (field->delta_size_bits != 0)) {
+            _TD1208_CODEC_write_bits(frame->ul_payload, &bit_idx, (code[idx] - context->previous_code[idx]), field->delta_size_bits);
+        }
+        else {
+            _TD1208_CODEC_write_bits(frame->ul_payload, &bit_idx, code[idx], field->size_bits);
+        }
+        context->previous_code[idx] = code[idx];
+    }
+    frame->ul_payload_size_bytes = (uint8_t) ((bit_idx + 7) >> 3);
+    // Update state.
+    context->delta_frames_count = (header == TD1208_CODEC_HEADER_DELTA) ? (uint8_t) (context->delta_frames_count + 1) : 0;
+    context->sequence = (uint8_t) ((context->sequence + 1) & TD1208_CODEC_SEQUENCE_MASK);
+    context->previous_valid = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_decode(TD1208_CODEC_context_t* context, const TD1208_CODEC_frame_t* frame, int32_t* values) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    const TD1208_CODEC_schema_t* schema = NULL;
+    const TD1208_CODEC_field_t* field = NULL;
+    uint32_t delta = 0;
+    uint8_t header = TD1208_CODEC_HEADER_ABSOLUTE;
+    uint8_t sequence = 0;
+    uint8_t bit_idx = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((context == NULL) || (context->schema == NULL) || (frame == NULL) || (values == NULL)) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    schema = context->schema;
+    if (frame->bit_frame != 0) {
+        // Single bit uplink updates the fast flag only (a lost frame can't be detected, other fields keep their last decoded value).
+        if ((context->previous_valid == 0) || (schema->fast_flag_field_idx == TD1208_CODEC_FAST_FLAG_NONE)) {
+            status = TD1208_ERROR_CODEC_FRAME;
+            goto errors;
+        }
+        context->previous_code[schema->fast_flag_field_idx] = (frame->ul_bit != 0) ? 1 : 0;
+    }
+    else {
+        // Check header and size.
+        if (frame->ul_payload_size_bytes == 0) {
+            status = TD1208_ERROR_CODEC_FRAME;
+            goto errors;
+        }
+        header = (uint8_t) _TD1208_CODEC_read_bits(frame->ul_payload, &bit_idx, TD1208_CODEC_TYPE_SIZE_BITS);
+        sequence = (uint8_t) _TD1208_CODEC_read_bits(frame->ul_payload, &bit_idx, TD1208_CODEC_SEQUENCE_SIZE_BITS);
+        if (((header == TD1208_CODEC_HEADER_DELTA) && (context->previous_valid == 0)) || (frame->ul_payload_size_bytes != ((_TD1208_CODEC_get_frame_size_bits(schema, header) + 7) >> 3))) {
+            status = TD1208_ERROR_CODEC_FRAME;
+            goto errors;
+        }
+        // A gap in the sequence means that a frame has been lost: delta frames can't be applied until the next absolute frame.
+        if ((header == TD1208_CODEC_HEADER_DELTA) && (sequence != context->sequence)) {
+            context->previous_valid = 0;
+            status = TD1208_ERROR_CODEC_FRAME;
+            goto errors;
+        }
+        // Unpack fields.
+        for (idx = 0; idx < schema->fields_count; idx++) {
+            field = &(schema->fields[idx]);
+            if ((header == TD1208_CODEC_HEADER_DELTA) && (field->delta_size_bits != 0)) {
+                delta = _TD1208_CODEC_read_bits(frame->ul_payload, &bit_idx, field->delta_size_bits);
+                // Sign extension.
+                if ((field->delta_size_bits < 32) && (((delta >> (field->delta_size_bits - 1)) & 0x01) != 0)) {
+                    delta |= ~(((uint32_t) 1 << field->delta_size_bits) - 1);
+                }
+                context->previous_code[idx] += delta;
+            }
+            else {
+                context->previous_code[idx] = _TD1208_CODEC_read_bits(frame->ul_payload, &bit_idx, field->size_bits);
+            }
+        }
+        context->sequence = (uint8_t) ((sequence + 1) & TD1208_CODEC_SEQUENCE_MASK);
+        context->previous_valid = 1;
+    }
+    // Convert to values.
+    for (idx = 0; idx < schema->fields_count; idx++) {
+        values[idx] = _TD1208_CODEC_dequantize(&(schema->fields[idx]), context->previous_code[idx]);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_send(TD1208_CODEC_context_t* context, const int32_t* values) {
+    // Use default instance.
+    return _TD1208_CODEC_send(NULL, context, values);
+}
+
+/*******************************************************************/
+TD1208_status_t TD1208_CODEC_instance_send(TD1208_handle_t* handle, TD1208_CODEC_context_t* context, const int32_t* values) {
+    // Local variables.
+    TD1208_status_t status = TD1208_SUCCESS;
+    // Check parameter.
+    if (handle == NULL) {
+        status = TD1208_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    status = _TD1208_CODEC_send(handle, context, values);
+errors:
+    return status;
+}
+
+#endif /* TD1208_DRIVER_DISABLE */
@@ -44,6 +44,25 @@ TD1208_status_t __attribute__((weak)) TD1208_HW_uart_write(uint8_t* data, uint32
     return status;
 }
 
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_uart_write_vector(TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(buffers);
+    UNUSED(buffers_count);
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_set_baud_rate(uint32_t baud_rate) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(baud_rate);
+    return status;
+}
+
 /*******************************************************************/
 TD1208_status_t __attribute__((weak)) TD1208_HW_delay_milliseconds(uint32_t delay_ms) {
     // Local variables.
@@ -53,4 +72,223 @@ TD1208_status_t __attribute__((weak)) TD1208_HW_delay_milliseconds(uint32_t dela
     return status;
 }
 
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_wait_event(uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(timeout_ms);
+    UNUSED(elapsed_ms);
+    return status;
+}
+
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_signal_event(void) {
+    /* Optional */
+}
+
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_sleep_until_event(uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(timeout_ms);
+    UNUSED(elapsed_ms);
+    return status;
+}
+
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_get_power_state(uint8_t* module_powered) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(module_powered);
+    return status;
+}
+
+#ifdef TD1208_DRIVER_THREAD_SAFE
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_mutex_lock(void) {
+    /* Optional */
+}
+
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_mutex_unlock(void) {
+    /* Optional */
+}
+
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_transaction_lock(void) {
+    // Transactions keep the state mutex while waiting when no dedicated mutex is provided.
+    TD1208_HW_mutex_lock();
+}
+
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_transaction_unlock(void) {
+    // Give the state mutex taken by the default lock function.
+    TD1208_HW_mutex_unlock();
+}
+#endif
+
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_enter_critical(void) {
+    /* Optional */
+}
+
+/*******************************************************************/
+void __attribute__((weak)) TD1208_HW_exit_critical(void) {
+    /* Optional */
+}
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+TD1208_status_t __attribute__((weak)) TD1208_HW_get_time_ms(uint32_t* time_ms) {
+    // Local variables.
+    TD1208_status_t status = TD1208_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* Optional */
+    UNUSED(time_ms);
+    return status;
+}
+#endif
+
+/*** TD1208 HW local functions ***/
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_init(void* hw_context, TD1208_HW_configuration_t* configuration) {
+    UNUSED(hw_context);
+    return TD1208_HW_init(configuration);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_de_init(void* hw_context) {
+    UNUSED(hw_context);
+    return TD1208_HW_de_init();
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_uart_write(void* hw_context, uint8_t* data, uint32_t data_size_bytes) {
+    UNUSED(hw_context);
+    return TD1208_HW_uart_write(data, data_size_bytes);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_uart_write_vector(void* hw_context, TD1208_HW_uart_buffer_t* buffers, uint8_t buffers_count) {
+    UNUSED(hw_context);
+    return TD1208_HW_uart_write_vector(buffers, buffers_count);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_set_baud_rate(void* hw_context, uint32_t baud_rate) {
+    UNUSED(hw_context);
+    return TD1208_HW_set_baud_rate(baud_rate);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_delay_milliseconds(void* hw_context, uint32_t delay_ms) {
+    UNUSED(hw_context);
+    return TD1208_HW_delay_milliseconds(delay_ms);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_wait_event(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    UNUSED(hw_context);
+    return TD1208_HW_wait_event(timeout_ms, elapsed_ms);
+}
+
+/*******************************************************************/
+static void _TD1208_HW_default_signal_event(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_signal_event();
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_sleep_until_event(void* hw_context, uint32_t timeout_ms, uint32_t* elapsed_ms) {
+    UNUSED(hw_context);
+    return TD1208_HW_sleep_until_event(timeout_ms, elapsed_ms);
+}
+
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_get_power_state(void* hw_context, uint8_t* module_powered) {
+    UNUSED(hw_context);
+    return TD1208_HW_get_power_state(module_powered);
+}
+
+#ifdef TD1208_DRIVER_THREAD_SAFE
+/*******************************************************************/
+static void _TD1208_HW_default_mutex_lock(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_mutex_lock();
+}
+
+/*******************************************************************/
+static void _TD1208_HW_default_mutex_unlock(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_mutex_unlock();
+}
+
+/*******************************************************************/
+static void _TD1208_HW_default_transaction_lock(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_transaction_lock();
+}
+
+/*******************************************************************/
+static void _TD1208_HW_default_transaction_unlock(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_transaction_unlock();
+}
+#endif
+
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+/*******************************************************************/
+static void _TD1208_HW_default_enter_critical(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_enter_critical();
+}
+
+/*******************************************************************/
+static void _TD1208_HW_default_exit_critical(void* hw_context) {
+    UNUSED(hw_context);
+    TD1208_HW_exit_critical();
+}
+#endif
+
+#ifdef TD1208_DRIVER_CAPTURE
+/*******************************************************************/
+static TD1208_status_t _TD1208_HW_default_get_time_ms(void* hw_context, uint32_t* time_ms) {
+    UNUSED(hw_context);
+    return TD1208_HW_get_time_ms(time_ms);
+}
+#endif
+
+/*** TD1208 HW global variables ***/
+
+const TD1208_HW_ops_t TD1208_HW_DEFAULT_OPS = {
+    .init = &_TD1208_HW_default_init,
+    .de_init = &_TD1208_HW_default_de_init,
+    .uart_write = &_TD1208_HW_default_uart_write,
+    .uart_write_vector = &_TD1208_HW_default_uart_write_vector,
+    .set_baud_rate = &_TD1208_HW_default_set_baud_rate,
+    .delay_milliseconds = &_TD1208_HW_default_delay_milliseconds,
+    .wait_event = &_TD1208_HW_default_wait_event,
+    .signal_event = &_TD1208_HW_default_signal_event,
+    .sleep_until_event = &_TD1208_HW_default_sleep_until_event,
+    .get_power_state = &_TD1208_HW_default_get_power_state,
+#ifdef TD1208_DRIVER_THREAD_SAFE
+    .mutex_lock = &_TD1208_HW_default_mutex_lock,
+    .mutex_unlock = &_TD1208_HW_default_mutex_unlock,
+    .transaction_lock = &_TD1208_HW_default_transaction_lock,
+    .transaction_unlock = &_TD1208_HW_default_transaction_unlock,
+#endif
+#if (defined TD1208_DRIVER_THREAD_SAFE) || (defined TD1208_DRIVER_CAPTURE)
+    .enter_critical = &_TD1208_HW_default_enter_critical,
+    .exit_critical = &_TD1208_HW_default_exit_critical,
+#endif
+#ifdef TD1208_DRIVER_CAPTURE
+    .get_time_ms = &_TD1208_HW_default_get_time_ms
+#endif
+};
+
 #endif /* TD1208_DRIVER_DISABLE */